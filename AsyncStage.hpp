@@ -0,0 +1,259 @@
+#pragma once
+
+#include "SpscQueue.hpp"
+#include "WorkerPool.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+enum class AsyncMode
+{
+    // The result for step k is published at step k + latency, waiting for it
+    // if necessary. Outputs are reproducible run to run.
+    Fixed,
+    // The most recent completed result is published and a step never waits.
+    // Inputs submitted while `latency` inputs are queued or in computation are dropped.
+    Latest
+};
+
+/**
+ * Runs an expensive computation (solver, planner) on a background thread,
+ * so the simulation step only copies the inputs in and the results out:
+ *
+ *   struct PlannerInput { std::array<real_T, 6> pose; std::array<real_T, 3> goal; };
+ *   struct PlannerOutput { std::array<real_T, 30> path; };
+ *
+ *   AsyncStage<PlannerInput, PlannerOutput> planner;
+ *
+ *   mdlStart:     planner.Start([](const PlannerInput &in, PlannerOutput &out) { Plan(in, out); }, 2);
+ *   mdlOutputs:   const PlannerOutput &result = planner.Step([&](PlannerInput &in) { Ports::Gather(S, in); });
+ *   mdlTerminate: planner.Stop();
+ *
+ * Inputs and results travel through two SpscQueues whose slots are
+ * allocated in Start(), so Step() neither locks nor allocates. Until the
+ * first result is available, Step() returns the initial output. The
+ * compute function runs on the worker thread, must not throw, and must
+ * write all of its output, since result slots are reused.
+ */
+template <typename Input, typename Output>
+class AsyncStage
+{
+public:
+    using Compute = std::function<void(const Input &, Output &)>;
+
+    AsyncStage() = default;
+    AsyncStage(const AsyncStage &) = delete;
+    AsyncStage &operator=(const AsyncStage &) = delete;
+    ~AsyncStage() { Stop(); }
+
+    /**
+     * Start the worker. latency is the number of steps between submitting an
+     * input and publishing its result (at least 1). Returns false if the stage
+     * is running, latency is 0 or the thread could not be created.
+     */
+    bool Start(Compute compute, size_t latency = 1, AsyncMode mode = AsyncMode::Fixed, Output initial = Output(),
+               unsigned spinIterations = SFU_WORKER_SPIN_ITERATIONS)
+    {
+        if (worker_.joinable() || latency == 0 || !compute)
+            return false;
+
+        compute_ = std::move(compute);
+        latency_ = latency;
+        mode_ = mode;
+        initial_ = std::move(initial);
+        spinIterations_ = std::thread::hardware_concurrency() > 1 ? spinIterations : 0;
+        // In flight: `latency` inputs, plus one result held by the simulation thread
+        inputs_.Reserve(latency + 1);
+        results_.Reserve(latency + 2);
+        holding_ = false;
+        steps_ = 0;
+        dropped_ = 0;
+        stop_.store(false, std::memory_order_relaxed);
+
+        try
+        {
+            worker_ = std::thread([this] { WorkerLoop(); });
+        }
+        catch (const std::system_error &)
+        {
+            return false;
+        }
+        return true;
+    }
+
+    /** Finish the computation in progress and join the worker; queued inputs are discarded. */
+    void Stop()
+    {
+        if (!worker_.joinable())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(parkMutex_);
+            stop_.store(true, std::memory_order_seq_cst);
+        }
+        parkCondition_.notify_one();
+        worker_.join();
+    }
+
+    bool Running() const noexcept { return worker_.joinable(); }
+
+    /**
+     * Submit this step's input, filled in place by fill(Input &), and return
+     * the output to publish. The reference stays valid until the next Step().
+     * Only call between Start() and Stop().
+     */
+    template <typename Fill, std::enable_if_t<std::is_invocable_v<Fill &, Input &>, int> = 0>
+    const Output &Step(Fill &&fill)
+    {
+        if (!worker_.joinable())
+            return initial_;
+        // The queue holds more than `latency` inputs after rounding to a power of two, so
+        // Latest bounds the inputs in flight (queued or in computation) explicitly.
+        // Fixed never has more than `latency` in flight when it submits.
+        Input *slot = mode_ == AsyncMode::Latest && inputs_.size() >= latency_ ? nullptr : inputs_.Back();
+        if (slot)
+        {
+            fill(*slot);
+            inputs_.Push();
+            WakeWorker();
+        }
+        else
+            ++dropped_;
+        ++steps_;
+
+        if (mode_ == AsyncMode::Fixed)
+        {
+            if (steps_ <= latency_)
+                return initial_;
+            ReleaseHeld();
+            const Output &result = WaitForResult();
+            holding_ = true;
+            return result;
+        }
+
+        // Latest: keep the newest completed result
+        if (!holding_)
+        {
+            if (!results_.Front())
+                return initial_;
+            holding_ = true;
+        }
+        while (results_.size() > 1)
+            results_.Pop();
+        return *results_.Front();
+    }
+
+    /** Submit a copy of input, see Step(Fill). */
+    const Output &Step(const Input &input)
+    {
+        return Step([&](Input &slot) { slot = input; });
+    }
+
+    size_t latency() const noexcept { return latency_; }
+
+    /** Inputs not submitted because the worker was too far behind (AsyncMode::Latest). */
+    size_t dropped() const noexcept { return dropped_; }
+
+private:
+    void ReleaseHeld()
+    {
+        if (holding_)
+        {
+            results_.Pop();
+            holding_ = false;
+        }
+    }
+
+    const Output &WaitForResult()
+    {
+        unsigned spins = 0;
+        const Output *result;
+        while ((result = results_.Front()) == nullptr)
+        {
+            if (spins++ < spinIterations_)
+                worker_pool_detail::CpuRelax();
+            else
+                std::this_thread::yield();
+        }
+        return *result;
+    }
+
+    void WakeWorker()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (parked_.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock(parkMutex_);
+            parkCondition_.notify_one();
+        }
+    }
+
+    void WorkerLoop()
+    {
+        while (true)
+        {
+            const Input *input = WaitFor([&] { return inputs_.Front(); });
+            if (!input)
+                return;
+            Output *result = WaitFor([&] { return results_.Back(); });
+            if (!result)
+                return;
+            compute_(*input, *result);
+            results_.Push();
+            inputs_.Pop();
+        }
+    }
+
+    // Spin, then park until poll() returns a slot; nullptr once stopped
+    template <typename Poll>
+    auto WaitFor(Poll &&poll) -> decltype(poll())
+    {
+        unsigned spins = 0;
+        while (true)
+        {
+            if (stop_.load(std::memory_order_relaxed))
+                return nullptr;
+            if (auto slot = poll())
+                return slot;
+            if (spins++ < spinIterations_)
+            {
+                worker_pool_detail::CpuRelax();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(parkMutex_);
+            parked_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            // Results are consumed without a wake-up, so do not sleep indefinitely on a full result queue
+            parkCondition_.wait_for(lock, std::chrono::milliseconds(1), [&]
+                                    { return stop_.load(std::memory_order_relaxed) || poll() != nullptr; });
+            parked_.store(false, std::memory_order_relaxed);
+            spins = 0;
+        }
+    }
+
+    Compute compute_;
+    size_t latency_ = 1;
+    AsyncMode mode_ = AsyncMode::Fixed;
+    Output initial_{};
+    unsigned spinIterations_ = 0;
+
+    SpscQueue<Input> inputs_;
+    SpscQueue<Output> results_;
+
+    // Simulation thread only; the published result stays at the front of results_
+    bool holding_ = false;
+    size_t steps_ = 0;
+    size_t dropped_ = 0;
+
+    std::thread worker_;
+    std::atomic<bool> stop_{false};
+    std::atomic<bool> parked_{false};
+    std::mutex parkMutex_;
+    std::condition_variable parkCondition_;
+};
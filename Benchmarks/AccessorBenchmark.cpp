@@ -0,0 +1,607 @@
+/*
+ * Microbenchmarks for the port and parameter accessors, run on the host
+ * SimStruct stand-in (Host/simstruc.h).
+ *
+ * Every Get*InputPort / Set*OutputPort overload, the port views, PortTable,
+ * PortBinding, the converting port copies and the extractSFunctionParameter
+ * specializations are timed for all port data types and sizes from 1 to 1M
+ * elements, next to a plain memcpy of the same data. For each accessor the benchmark reports
+ *
+ *   ns/elem      time per call divided by the number of elements
+ *   x memcpy     ns/elem relative to the memcpy baseline
+ *   allocs/call  calls to operator new per accessor call
+ *
+ * Build and run (from the repository root):
+ *
+ *   g++ -std=c++17 -O2 -DNDEBUG -IHost -I. Benchmarks/AccessorBenchmark.cpp -o accessor_benchmark
+ *   ./accessor_benchmark [--max-elements N] [--min-time SECONDS] [--filter TEXT] [--csv]
+ *
+ * --filter only runs accessors whose name contains TEXT, e.g. --filter Matrix.
+ */
+
+#include "HostSimulation.hpp"
+#include "IO.hpp"
+#include "PortTable.hpp"
+#include "PortBinding.hpp"
+#include "Parameters.hpp"
+#include "ParameterCache.hpp"
+#include "MaskTable.hpp"
+#include "StringPool.hpp"
+#include "Conversion.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* ------------------------------------------------------ allocation count -- */
+
+static size_t allocationCount = 0;
+
+// GCC reports the malloc/free pair below as mismatched once it inlines the replacement
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void *operator new(size_t size)
+{
+    ++allocationCount;
+    if (void *memory = std::malloc(size ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+void operator delete(void *memory, size_t) noexcept { std::free(memory); }
+
+/* ------------------------------------------------------------- harness -- */
+
+struct BenchmarkOptions
+{
+    size_t maxElements = size_t(1) << 20;
+    double minSeconds = 0.01;
+    const char *filter = nullptr;
+    bool csv = false;
+};
+
+static BenchmarkOptions options;
+
+// Largest std::array an accessor may return by value in this benchmark
+constexpr size_t MaxStackBytes = 64 * 1024;
+// Largest number of cells in a cell array parameter
+constexpr size_t MaxCells = 64 * 1024;
+
+/** Keep the compiler from optimizing away the result of an accessor. */
+template <typename T>
+inline void KeepAlive(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const void *volatile sink;
+    sink = &value;
+#endif
+}
+
+struct Measurement
+{
+    double nsPerElement = 0.0;
+    double allocationsPerCall = 0.0;
+    const char *error = nullptr;
+};
+
+/** Run body in batches of doubling size until one batch takes options.minSeconds. */
+template <typename Body>
+Measurement Measure(SimStruct *S, size_t elements, Body &body)
+{
+    typedef std::chrono::steady_clock Clock;
+    S->errorStatus = nullptr;
+    body();
+    for (size_t iterations = 1;; iterations *= 2)
+    {
+        const size_t allocationsBefore = allocationCount;
+        const Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+            body();
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        Measurement result;
+        if (S->errorStatus)
+        {
+            result.error = S->errorStatus;
+            return result;
+        }
+        if (seconds >= options.minSeconds || iterations >= (size_t(1) << 34))
+        {
+            result.nsPerElement = seconds * 1e9 / ((double)iterations * (double)elements);
+            result.allocationsPerCall = (double)(allocationCount - allocationsBefore) / (double)iterations;
+            return result;
+        }
+    }
+}
+
+/** One row of output: a data type and element count. */
+struct BenchmarkGroup
+{
+    SimStruct *S;
+    const char *type;
+    size_t elements;
+    // ns/elem of the memcpy baseline, 0 if there is none
+    double baseline;
+};
+
+static void PrintHeader()
+{
+    if (options.csv)
+        std::printf("type,elements,accessor,ns_per_element,relative_to_memcpy,allocations_per_call\n");
+    else
+        std::printf("%-8s %9s  %-62s %10s %9s %12s\n", "type", "elements", "accessor", "ns/elem", "x memcpy", "allocs/call");
+}
+
+static void PrintRow(const BenchmarkGroup &group, const char *accessor, const Measurement &result)
+{
+    if (result.error)
+    {
+        std::printf(options.csv ? "%s,%zu,%s,error: %s\n" : "%-8s %9zu  %-62s error: %s\n",
+                    group.type, group.elements, accessor, result.error);
+        return;
+    }
+    // Cell array parameters have no memcpy equivalent
+    char relative[32] = "";
+    if (group.baseline > 0.0)
+        std::snprintf(relative, sizeof(relative), "%.3g", result.nsPerElement / group.baseline);
+    else if (!options.csv)
+        std::snprintf(relative, sizeof(relative), "-");
+    std::printf(options.csv ? "%s,%zu,%s,%.4g,%s,%.2f\n" : "%-8s %9zu  %-62s %10.4g %9s %12.2f\n",
+                group.type, group.elements, accessor, result.nsPerElement, relative, result.allocationsPerCall);
+}
+
+template <typename Body>
+void Run(const BenchmarkGroup &group, const char *accessor, Body &&body)
+{
+    if (options.filter && !std::strstr(accessor, options.filter))
+        return;
+    PrintRow(group, accessor, Measure(group.S, group.elements, body));
+    std::fflush(stdout);
+}
+
+template <typename Body>
+void RunBaseline(BenchmarkGroup &group, Body &&body)
+{
+    const Measurement result = Measure(group.S, group.elements, body);
+    group.baseline = result.nsPerElement;
+    PrintRow(group, "memcpy", result);
+}
+
+/* --------------------------------------------------------------- ports -- */
+
+/**
+ * All port accessors for a Side x Side port of type T. The fixed-size
+ * overloads need the dimensions at compile time, hence the template.
+ */
+template <typename T, size_t Side>
+void BenchmarkPorts(const char *typeName)
+{
+    constexpr size_t W = Side;
+    constexpr size_t H = Side;
+    constexpr size_t N = W * H;
+    if (N > options.maxElements)
+        return;
+
+    SimStruct simStruct;
+    SimStruct *S = &simStruct;
+    ssSetNumInputPorts(S, 1);
+    ssSetNumOutputPorts(S, 1);
+    Define2DMatrixInputPort<T>(S, 0, (int)H, (int)W);
+    Define2DMatrixOutputPort<T>(S, 0, (int)H, (int)W);
+    HostAllocatePorts(S);
+    const T *input = static_cast<const T *>(ssGetInputPortSignal(S, 0));
+    T *output = static_cast<T *>(ssGetOutputPortSignal(S, 0));
+
+    // Caller-side buffers in every shape the overloads accept
+    std::unique_ptr<T[]> buffer(new T[N]());
+    std::vector<T *> rowPointers(W);
+    for (size_t i = 0; i < W; ++i)
+        rowPointers[i] = buffer.get() + i * H;
+    struct Array2D
+    {
+        T values[W][H];
+    };
+    std::unique_ptr<Array2D> array2D(new Array2D());
+    std::unique_ptr<std::array<T, N>> array1D(new std::array<T, N>());
+    std::unique_ptr<std::array<std::array<T, H>, W>> nestedArray(new std::array<std::array<T, H>, W>());
+    const std::vector<T> sourceVector(N);
+    const std::vector<std::vector<T>> sourceNested(W, std::vector<T>(H));
+
+    struct BoundSignals
+    {
+        const T *input;
+        T *output;
+    };
+    typedef PortBinding<InputField<&BoundSignals::input, 0, N>, OutputField<&BoundSignals::output, 0, N>> Binding;
+    BoundSignals bound;
+    Binding::Validate(S);
+
+    PortTable table;
+    table.Bind(S);
+    table.ExpectInput<T>(0, N);
+    table.ExpectOutput<T>(0, N);
+
+    BenchmarkGroup group{S, typeName, N, 0.0};
+    RunBaseline(group, [&] {
+        std::memcpy(buffer.get(), input, N * sizeof(T));
+        KeepAlive(buffer[0]);
+    });
+
+    // Input ports
+    if constexpr (N == 1)
+    {
+        Run(group, "GetScalarInputPort<T>", [&] {
+            KeepAlive(GetScalarInputPort<T>(S, 0));
+        });
+    }
+    Run(group, "GetVectorInputPort<T>(width) -> std::vector", [&] {
+        KeepAlive(GetVectorInputPort<T>(S, 0, N));
+    });
+    if constexpr (N * sizeof(T) <= MaxStackBytes)
+    {
+        Run(group, "GetVectorInputPort<T, W>() -> std::array", [&] {
+            KeepAlive(GetVectorInputPort<T, N>(S, 0));
+        });
+    }
+    Run(group, "GetVectorInputPort<T, W>(T *)", [&] {
+        KeepAlive(GetVectorInputPort<T, N>(S, 0, buffer.get()));
+    });
+    Run(group, "Get2DMatrixInputPort<T>(width, height) -> vector<vector>", [&] {
+        KeepAlive(Get2DMatrixInputPort<T>(S, 0, W, H));
+    });
+    if constexpr (N * sizeof(T) <= MaxStackBytes)
+    {
+        Run(group, "Get2DMatrixInputPort<T, W, H>() -> array<array>", [&] {
+            KeepAlive(Get2DMatrixInputPort<T, W, H>(S, 0));
+        });
+    }
+    Run(group, "Get2DMatrixInputPort<T, W, H>(T *)", [&] {
+        KeepAlive(Get2DMatrixInputPort<T, W, H>(S, 0, buffer.get()));
+    });
+    Run(group, "Get2DMatrixInputPort<T, W, H>(T **)", [&] {
+        KeepAlive(Get2DMatrixInputPort<T, W, H>(S, 0, rowPointers.data()));
+    });
+    Run(group, "Get2DMatrixInputPort<T, W, H>(T (&)[W][H])", [&] {
+        KeepAlive(Get2DMatrixInputPort<T, W, H>(S, 0, array2D->values));
+    });
+    Run(group, "GetInputPort<T, W, H>(T *)", [&] {
+        KeepAlive(GetInputPort<T, W, H>(S, 0, buffer.get()));
+    });
+    Run(group, "GetInputPort<T>(T *, width, height)", [&] {
+        KeepAlive(GetInputPort<T>(S, 0, buffer.get(), W, H));
+    });
+    Run(group, "GetVectorInputPortView<T>", [&] {
+        KeepAlive(GetVectorInputPortView<T>(S, 0, N));
+    });
+    Run(group, "Get2DMatrixInputPortView<T>", [&] {
+        KeepAlive(Get2DMatrixInputPortView<T>(S, 0, H, W));
+    });
+    Run(group, "PortTable::Input<T>", [&] {
+        KeepAlive(table.Input<T>(0));
+    });
+    Run(group, "PortTable::InputView<T>", [&] {
+        KeepAlive(table.InputView<T>(0));
+    });
+    Run(group, "PortBinding::Gather (pointer fields)", [&] {
+        Binding::Gather(S, bound);
+        KeepAlive(bound);
+    });
+
+    // Output ports
+    if constexpr (N == 1)
+    {
+        Run(group, "SetScalarOutputPort<T>", [&] {
+            SetScalarOutputPort<T>(S, 0, buffer[0]);
+            KeepAlive(output[0]);
+        });
+    }
+    Run(group, "SetVectorOutputPort(const std::vector &)", [&] {
+        SetVectorOutputPort<T>(S, 0, sourceVector);
+        KeepAlive(output[0]);
+    });
+    Run(group, "SetVectorOutputPort(T *, size)", [&] {
+        SetVectorOutputPort<T>(S, 0, buffer.get(), N);
+        KeepAlive(output[0]);
+    });
+    Run(group, "SetVectorOutputPort<T, W>(T *)", [&] {
+        SetVectorOutputPort<T, N>(S, 0, buffer.get());
+        KeepAlive(output[0]);
+    });
+    Run(group, "SetVectorOutputPort<T, W>(const T *)", [&] {
+        SetVectorOutputPort<T, N>(S, 0, static_cast<const T *>(buffer.get()));
+        KeepAlive(output[0]);
+    });
+    Run(group, "SetVectorOutputPort(const std::array &)", [&] {
+        SetVectorOutputPort<T, N>(S, 0, *array1D);
+        KeepAlive(output[0]);
+    });
+    Run(group, "Set2DMatrixOutputPort(const vector<vector> &)", [&] {
+        Set2DMatrixOutputPort<T>(S, 0, sourceNested);
+        KeepAlive(output[0]);
+    });
+    Run(group, "Set2DMatrixOutputPort(T *, rows, cols)", [&] {
+        Set2DMatrixOutputPort<T>(S, 0, buffer.get(), H, W);
+        KeepAlive(output[0]);
+    });
+    Run(group, "Set2DMatrixOutputPort<T, W, H>(T *)", [&] {
+        Set2DMatrixOutputPort<T, W, H>(S, 0, buffer.get());
+        KeepAlive(output[0]);
+    });
+    Run(group, "Set2DMatrixOutputPort<T, W, H>(const array<array> &)", [&] {
+        Set2DMatrixOutputPort<T, W, H>(S, 0, *nestedArray);
+        KeepAlive(output[0]);
+    });
+    Run(group, "Set2DMatrixOutputPort<T, W, H>(T **)", [&] {
+        Set2DMatrixOutputPort<T, W, H>(S, 0, rowPointers.data());
+        KeepAlive(output[0]);
+    });
+    Run(group, "Set2DMatrixOutputPort<T, W, H>(T (&)[W][H])", [&] {
+        Set2DMatrixOutputPort<T, W, H>(S, 0, array2D->values);
+        KeepAlive(output[0]);
+    });
+    Run(group, "GetVectorOutputPortView<T>", [&] {
+        KeepAlive(GetVectorOutputPortView<T>(S, 0, N));
+    });
+    Run(group, "Get2DMatrixOutputPortView<T>", [&] {
+        KeepAlive(Get2DMatrixOutputPortView<T>(S, 0, H, W));
+    });
+    Run(group, "PortTable::Output<T>", [&] {
+        KeepAlive(table.Output<T>(0));
+    });
+    Run(group, "PortTable::OutputView<T>", [&] {
+        KeepAlive(table.OutputView<T>(0));
+    });
+}
+
+template <typename T, size_t... Sides>
+void BenchmarkPortSizes(const char *typeName, std::index_sequence<Sides...>)
+{
+    (BenchmarkPorts<T, Sides>(typeName), ...);
+}
+
+// Square ports of 1, 16, 256, 4096, 65536 and 1048576 elements
+typedef std::index_sequence<1, 4, 16, 64, 256, 1024> PortSides;
+
+/* --------------------------------------------------------- conversions -- */
+
+/** Converting copies between a port of type PortT and a buffer of type T. */
+template <typename PortT, typename T>
+void BenchmarkConversion(const char *typeName, size_t elements)
+{
+    SimStruct simStruct;
+    SimStruct *S = &simStruct;
+    ssSetNumInputPorts(S, 1);
+    ssSetNumOutputPorts(S, 1);
+    DefineVectorInputPort<PortT>(S, 0, (int)elements);
+    DefineVectorOutputPort<PortT>(S, 0, (int)elements);
+    HostAllocatePorts(S);
+    const PortT *input = static_cast<const PortT *>(ssGetInputPortSignal(S, 0));
+    std::vector<PortT> copy(elements);
+    std::vector<T> buffer(elements);
+    typedef conversion_detail::Compute<PortT, T> InputCompute;
+
+    BenchmarkGroup group{S, typeName, elements, 0.0};
+    RunBaseline(group, [&] {
+        std::memcpy(copy.data(), input, elements * sizeof(PortT));
+        KeepAlive(copy[0]);
+    });
+    Run(group, "GetInputPortConverted<PortT>", [&] {
+        KeepAlive(GetInputPortConverted<PortT>(S, 0, buffer.data(), elements, 0.5, 1.0));
+    });
+    Run(group, "GetInputPortConverted<PortT> (scalar kernel)", [&] {
+        conversion_detail::ConvertScalar<PortT, T>(input, buffer.data(), elements, InputCompute(0.5), InputCompute(1.0));
+        KeepAlive(buffer[0]);
+    });
+    Run(group, "SetVectorOutputPortConverted<PortT>", [&] {
+        SetVectorOutputPortConverted<PortT>(S, 0, buffer.data(), elements, 2.0, -1.0);
+        KeepAlive(copy[0]);
+    });
+}
+
+/* ---------------------------------------------------------- parameters -- */
+
+/** A SimStruct with a single dialog parameter it owns. */
+class ParameterFixture
+{
+public:
+    explicit ParameterFixture(mxArray *param) : param_(param)
+    {
+        ssSetNumSFcnParams(&S_, 1);
+        S_.sfcnParams.assign(1, param_);
+    }
+    ~ParameterFixture() { mxDestroyArray(param_); }
+
+    SimStruct *S() { return &S_; }
+    mxArray *Param() { return param_; }
+
+private:
+    SimStruct S_;
+    mxArray *param_;
+};
+
+static mxArray *CreateCharArray(size_t length)
+{
+    mxArray *param = mxCreateNumericMatrix(length ? 1 : 0, length, mxCHAR_CLASS);
+    mxChar *chars = static_cast<mxChar *>(mxGetData(param));
+    for (size_t i = 0; i < length; ++i)
+        chars[i] = (mxChar)('a' + i % 26);
+    return param;
+}
+
+static void BenchmarkNumericParameters(size_t elements)
+{
+    ParameterFixture fixture(mxCreateDoubleMatrix(1, elements));
+    SimStruct *S = fixture.S();
+    double *values = mxGetPr(fixture.Param());
+    for (size_t i = 0; i < elements; ++i)
+        values[i] = (double)(i % 1000);
+    std::vector<double> buffer(elements);
+
+    BenchmarkGroup group{S, "double", elements, 0.0};
+    RunBaseline(group, [&] {
+        std::memcpy(buffer.data(), values, elements * sizeof(double));
+        KeepAlive(buffer[0]);
+    });
+
+    if (elements == 1)
+    {
+        Run(group, "extractSFunctionParameter<double>", [&] {
+            KeepAlive(extractSFunctionParameter<double>(S, 0));
+        });
+        Run(group, "extractSFunctionParameter<int>", [&] {
+            KeepAlive(extractSFunctionParameter<int>(S, 0));
+        });
+        Run(group, "extractSFunctionParameter<bool>", [&] {
+            KeepAlive(extractSFunctionParameter<bool>(S, 0));
+        });
+    }
+    Run(group, "extractSFunctionParameter<std::vector<double>>", [&] {
+        KeepAlive(extractSFunctionParameter<std::vector<double>>(S, 0));
+    });
+    Run(group, "extractSFunctionParameter<std::vector<int>>", [&] {
+        KeepAlive(extractSFunctionParameter<std::vector<int>>(S, 0));
+    });
+    Run(group, "extractSFunctionParameterVector<float>", [&] {
+        KeepAlive(extractSFunctionParameterVector<float>(S, 0));
+    });
+    Run(group, "extractSFunctionParameterView<double>", [&] {
+        KeepAlive(extractSFunctionParameterView<double>(S, 0));
+    });
+
+    ParameterCache cache;
+    const ParameterHandle<std::vector<double>> handle = cache.Declare<std::vector<double>>(0);
+    cache.Parse(S);
+    Run(group, "ParameterCache::Update (unchanged)", [&] {
+        KeepAlive(cache.Update(S));
+    });
+    Run(group, "ParameterCache::Get", [&] {
+        KeepAlive(cache.Get(handle));
+    });
+}
+
+static void BenchmarkStringParameters(size_t elements)
+{
+    ParameterFixture fixture(CreateCharArray(elements));
+    SimStruct *S = fixture.S();
+    std::vector<mxChar> buffer(elements);
+
+    BenchmarkGroup group{S, "char", elements, 0.0};
+    RunBaseline(group, [&] {
+        std::memcpy(buffer.data(), mxGetData(fixture.Param()), elements * sizeof(mxChar));
+        KeepAlive(buffer[0]);
+    });
+    Run(group, "extractSFunctionParameter<std::string>", [&] {
+        KeepAlive(extractSFunctionParameter<std::string>(S, 0));
+    });
+    Run(group, "extractSFunctionParameter<InternedString>", [&] {
+        KeepAlive(extractSFunctionParameter<InternedString>(S, 0));
+    });
+}
+
+static void BenchmarkCellParameters(size_t cells)
+{
+    if (cells > MaxCells)
+        return;
+
+    ParameterFixture names(mxCreateCellMatrix(1, cells));
+    for (size_t i = 0; i < cells; ++i)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "signal_%zu", i % 100);
+        mxSetCell(names.Param(), i, mxCreateString(name));
+    }
+    BenchmarkGroup group{names.S(), "cellstr", cells, 0.0};
+    Run(group, "extractSFunctionParameter<std::vector<std::string>>", [&] {
+        KeepAlive(extractSFunctionParameter<std::vector<std::string>>(names.S(), 0));
+    });
+    Run(group, "extractSFunctionParameter<std::vector<InternedString>>", [&] {
+        KeepAlive(extractSFunctionParameter<std::vector<InternedString>>(names.S(), 0));
+    });
+
+    // Mask table with one numeric column stored as text, as the mask editor does
+    ParameterFixture maskTable(mxCreateCellMatrix(cells, 1));
+    for (size_t i = 0; i < cells; ++i)
+        mxSetCell(maskTable.Param(), i, mxCreateString("1.5"));
+    const std::vector<MaskColumnSpec> schema{{MaskColumnType::Double, {}}};
+    group.S = maskTable.S();
+    Run(group, "extractSFunctionMaskTable", [&] {
+        KeepAlive(extractSFunctionMaskTable(maskTable.S(), 0));
+    });
+    Run(group, "extractSFunctionMaskTable(schema)", [&] {
+        KeepAlive(extractSFunctionMaskTable(maskTable.S(), 0, schema));
+    });
+    Run(group, "extractSFunctionMaskTableInterned", [&] {
+        KeepAlive(extractSFunctionMaskTableInterned(maskTable.S(), 0));
+    });
+}
+
+/* ---------------------------------------------------------------- main -- */
+
+static bool ParseArguments(int argc, char **argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--max-elements") && hasValue)
+            options.maxElements = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--min-time") && hasValue)
+            options.minSeconds = std::strtod(argv[++i], nullptr);
+        else if (!std::strcmp(argv[i], "--filter") && hasValue)
+            options.filter = argv[++i];
+        else if (!std::strcmp(argv[i], "--csv"))
+            options.csv = true;
+        else
+        {
+            std::fprintf(stderr, "Usage: %s [--max-elements N] [--min-time SECONDS] [--filter TEXT] [--csv]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if (!ParseArguments(argc, argv))
+        return 1;
+
+    PrintHeader();
+    BenchmarkPortSizes<real_T>("double", PortSides());
+    BenchmarkPortSizes<real32_T>("single", PortSides());
+    BenchmarkPortSizes<int8_T>("int8", PortSides());
+    BenchmarkPortSizes<uint8_T>("uint8", PortSides());
+    BenchmarkPortSizes<int16_T>("int16", PortSides());
+    BenchmarkPortSizes<uint16_T>("uint16", PortSides());
+    BenchmarkPortSizes<int32_T>("int32", PortSides());
+    BenchmarkPortSizes<uint32_T>("uint32", PortSides());
+    BenchmarkPortSizes<bool>("boolean", PortSides());
+
+    if (!options.csv)
+        std::printf("# conversion kernels: %s\n", ConversionInstructionSetName(DetectConversionInstructionSet()));
+    for (size_t elements = 1; elements <= options.maxElements; elements *= 16)
+    {
+        BenchmarkConversion<uint8_T, real32_T>("u8>f32", elements);
+        BenchmarkConversion<int16_T, real32_T>("i16>f32", elements);
+        BenchmarkConversion<int16_T, real_T>("i16>f64", elements);
+        BenchmarkConversion<uint16_T, real_T>("u16>f64", elements);
+    }
+
+    for (size_t elements = 1; elements <= options.maxElements; elements *= 16)
+    {
+        BenchmarkNumericParameters(elements);
+        BenchmarkStringParameters(elements);
+        BenchmarkCellParameters(elements);
+    }
+    return 0;
+}
@@ -0,0 +1,305 @@
+/*
+ * Stress test for the threaded helpers, run on the host SimStruct stand-in
+ * (Host/simstruc.h). Meant to be built with a sanitizer, so data races and
+ * memory errors in the lock-free code show up without MATLAB:
+ *
+ *   WorkerPool      ParallelFor covers every index exactly once, also
+ *                   after the workers parked between calls
+ *   SpscQueue       values arrive complete and in order
+ *   AsyncStage      Fixed mode returns the result of exactly `latency`
+ *                   steps ago, also after the worker parked
+ *   SignalLogger    with SignalLogOverflow::Wait every record reaches the
+ *                   file, in order
+ *   FrameRingBuffer frames match a naive sliding window over the stream
+ *
+ * Build and run (from the repository root):
+ *
+ *   g++ -std=c++17 -O1 -g -fsanitize=thread -IHost -I. Benchmarks/ConcurrencyStress.cpp -o concurrency_stress
+ *   ./concurrency_stress [--log PATH]
+ *
+ * (or -fsanitize=address,undefined). Exits with 1 if any check fails.
+ * GCC warns that TSan does not model the fences in AsyncStage's park/wake
+ * handshake; a wake-up missed there only delays the worker by its 1 ms
+ * park timeout and does not affect the results checked here.
+ */
+
+#include "HostSimulation.hpp"
+#include "WorkerPool.hpp"
+#include "AsyncStage.hpp"
+#include "SignalLogger.hpp"
+#include "Frames.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+
+static void Check(bool ok, const char *name)
+{
+    std::printf("%-48s %s\n", name, ok ? "ok" : "FAILED");
+    if (!ok)
+        ++failures;
+}
+
+// Long enough for the workers to stop spinning and park
+static void LetWorkersPark()
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+}
+
+/* ---------------------------------------------------------- WorkerPool -- */
+
+static void StressWorkerPool()
+{
+    WorkerPool pool;
+    if (!pool.Start(4, false))
+    {
+        Check(false, "WorkerPool::Start");
+        return;
+    }
+
+    std::vector<std::atomic<int>> hits(50021);
+    bool covered = true;
+    for (int call = 0; call < 1000 && covered; ++call)
+    {
+        const size_t count = 1 + (size_t)call * 7919 % hits.size();
+        for (std::atomic<int> &hit : hits)
+            hit.store(0, std::memory_order_relaxed);
+        pool.ParallelFor(count, [&](size_t begin, size_t end)
+                         {
+                             for (size_t i = begin; i < end; ++i)
+                                 hits[i].fetch_add(1, std::memory_order_relaxed);
+                         },
+                         (size_t)call % 64 + 1);
+        for (size_t i = 0; i < hits.size(); ++i)
+        {
+            if (hits[i].load(std::memory_order_relaxed) != (i < count ? 1 : 0))
+            {
+                covered = false;
+                break;
+            }
+        }
+        if (call % 100 == 0)
+            LetWorkersPark();
+    }
+    Check(covered, "WorkerPool::ParallelFor coverage");
+
+    // Plain writes from the body must be visible once ParallelFor returns
+    std::vector<size_t> values(4096);
+    bool visible = true;
+    for (int call = 0; call < 200 && visible; ++call)
+    {
+        pool.ParallelFor(values.size(), [&](size_t begin, size_t end)
+                         {
+                             for (size_t i = begin; i < end; ++i)
+                                 values[i] = i + (size_t)call;
+                         });
+        for (size_t i = 0; i < values.size(); ++i)
+            visible = visible && values[i] == i + (size_t)call;
+        if (call % 50 == 0)
+            LetWorkersPark();
+    }
+    Check(visible, "WorkerPool::ParallelFor results visible");
+
+    pool.Stop();
+    Check(pool.Start(2, false), "WorkerPool restart after Stop");
+}
+
+/* ---------------------------------------------------------- SpscQueue -- */
+
+static void StressSpscQueue()
+{
+    constexpr long count = 200000;
+    SpscQueue<std::array<long, 4>> queue(64);
+    std::thread producer([&]
+                         {
+                             for (long i = 0; i < count; ++i)
+                             {
+                                 while (!queue.TryPush({i, i + 1, i + 2, i + 3}))
+                                     std::this_thread::yield();
+                             } });
+
+    bool ordered = true;
+    for (long expected = 0; expected < count;)
+    {
+        std::array<long, 4> value;
+        if (!queue.TryPop(value))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        ordered = ordered && value[0] == expected && value[3] == expected + 3;
+        ++expected;
+    }
+    producer.join();
+    Check(ordered, "SpscQueue order and completeness");
+}
+
+/* --------------------------------------------------------- AsyncStage -- */
+
+struct StageInput
+{
+    int step;
+    std::array<double, 16> samples;
+};
+
+struct StageOutput
+{
+    int step = -1;
+    double sum = 0.0;
+};
+
+static void StressAsyncStage()
+{
+    for (size_t latency : {1, 2, 5})
+    {
+        AsyncStage<StageInput, StageOutput> stage;
+        const bool started = stage.Start([](const StageInput &in, StageOutput &out)
+                                         {
+                                             out.step = in.step;
+                                             out.sum = 0.0;
+                                             for (double sample : in.samples)
+                                                 out.sum += sample;
+                                             // Uneven compute times, some longer than a step
+                                             std::this_thread::sleep_for(std::chrono::microseconds(in.step % 7 * 20)); },
+                                         latency);
+        bool exact = started;
+        for (int step = 0; step < 500 && exact; ++step)
+        {
+            const StageOutput &out = stage.Step([&](StageInput &in)
+                                                {
+                                                    in.step = step;
+                                                    in.samples.fill(step); });
+            const int expected = step - (int)latency;
+            if (expected < 0)
+                exact = out.step == -1;
+            else
+                exact = out.step == expected && out.sum == 16.0 * expected;
+            if (step % 100 == 50)
+                LetWorkersPark();
+        }
+        stage.Stop();
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "AsyncStage Fixed latency %zu", latency);
+        Check(exact && stage.dropped() == 0, name);
+    }
+}
+
+/* ------------------------------------------------------- SignalLogger -- */
+
+static void StressSignalLogger(const char *path)
+{
+    constexpr size_t steps = 20000;
+    constexpr int width = 8;
+
+    SimStruct simStruct;
+    SimStruct *S = &simStruct;
+    ssSetNumInputPorts(S, 1);
+    ssSetNumOutputPorts(S, 0);
+    DefineVectorInputPort<real_T>(S, 0, width);
+    HostAllocatePorts(S);
+    // The host port buffers are owned by the stand-in and writable
+    real_T *input = const_cast<real_T *>(static_cast<const real_T *>(ssGetInputPortSignal(S, 0)));
+
+    {
+        // A small ring buffer, so Log() keeps catching up with the background thread
+        SignalLogger logger;
+        if (!logger.AddInputPort(S, 0, "u") || !logger.Open(S, path, steps, 16, SignalLogOverflow::Wait))
+        {
+            Check(false, "SignalLogger::Open");
+            return;
+        }
+        for (size_t step = 0; step < steps; ++step)
+        {
+            S->t = (time_T)step;
+            for (int i = 0; i < width; ++i)
+                input[i] = (real_T)(step * width + i);
+            logger.Log(S);
+        }
+        logger.Close();
+    }
+
+    SignalLogReader reader;
+    bool complete = reader.Open(path) && reader.recordCount() == steps && reader.dropped() == 0;
+    for (size_t record = 0; complete && record < steps; ++record)
+    {
+        const real_T *samples = reader.Samples<real_T>(record, 0);
+        complete = reader.Time(record) == (double)record && samples[0] == (real_T)(record * width) &&
+                   samples[width - 1] == (real_T)(record * width + width - 1);
+    }
+    reader.Close();
+    std::remove(path);
+    Check(complete, "SignalLogger Wait mode records complete");
+}
+
+/* ---------------------------------------------------- FrameRingBuffer -- */
+
+static void CheckFrameRingBuffer(size_t frameSize, size_t overlap, size_t chunk)
+{
+    const size_t hop = frameSize - overlap;
+    std::vector<real_T> stream(20 * frameSize + 3);
+    for (size_t i = 0; i < stream.size(); ++i)
+        stream[i] = (real_T)i;
+
+    FrameRingBuffer<real_T> buffer(frameSize, overlap);
+    size_t frames = 0;
+    bool match = true;
+    for (size_t offset = 0; offset < stream.size(); offset += chunk)
+    {
+        const size_t count = std::min(chunk, stream.size() - offset);
+        buffer.Push(stream.data() + offset, count, [&](InputPortView<real_T> frame)
+                    {
+                        // Naive reference: frame n is stream[n * hop, n * hop + frameSize)
+                        match = match && frame.size() == frameSize &&
+                                std::equal(frame.begin(), frame.end(), stream.begin() + frames * hop);
+                        ++frames; });
+    }
+    const size_t expectedFrames = (stream.size() - frameSize) / hop + 1;
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "FrameRingBuffer %zu/%zu, chunks of %zu", frameSize, overlap, chunk);
+    Check(match && frames == expectedFrames, name);
+}
+
+static void StressFrameRingBuffer()
+{
+    for (size_t chunk : {1, 7, 64, 1000})
+    {
+        CheckFrameRingBuffer(64, 0, chunk);
+        CheckFrameRingBuffer(64, 48, chunk);
+        CheckFrameRingBuffer(50, 13, chunk);
+    }
+}
+
+/* --------------------------------------------------------------- main -- */
+
+int main(int argc, char **argv)
+{
+    const char *logPath = "concurrency_stress.sfulog";
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--log") == 0 && i + 1 < argc)
+            logPath = argv[++i];
+        else
+        {
+            std::fprintf(stderr, "Usage: %s [--log PATH]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    StressWorkerPool();
+    StressSpscQueue();
+    StressAsyncStage();
+    StressSignalLogger(logPath);
+    StressFrameRingBuffer();
+
+    std::printf("%d check(s) failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,275 @@
+#pragma once
+
+#include "IO.hpp"
+#include "PortTable.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace bus_detail
+{
+    template <typename M>
+    struct ElementShape
+    {
+        using element = std::remove_all_extents_t<M>;
+        static constexpr size_t width = sizeof(M) / sizeof(element);
+    };
+    template <typename T, size_t N>
+    struct ElementShape<std::array<T, N>>
+    {
+        using element = T;
+        static constexpr size_t width = N;
+    };
+
+    template <typename... Fields>
+    constexpr bool OffsetsAscending()
+    {
+        constexpr size_t offsets[] = {Fields::offset...};
+        for (size_t i = 1; i < sizeof...(Fields); ++i)
+        {
+            if (offsets[i] <= offsets[i - 1])
+                return false;
+        }
+        return true;
+    }
+
+    // boolean_T is the same type as uint8_T, so it also matches boolean bus elements
+    template <typename T>
+    constexpr bool MatchesDataType(DTypeId id)
+    {
+        return id == DataTypeTraits<T>::id || (std::is_same_v<T, boolean_T> && id == SS_BOOLEAN);
+    }
+}
+
+/**
+ * One element of a bus: a member of type Member at byte offset Offset of
+ * the struct. Declare with SFU_BUS_FIELD(Struct, member).
+ */
+template <typename Member, size_t Offset>
+struct BusField
+{
+    using type = Member;
+    using element = typename bus_detail::ElementShape<Member>::element;
+
+    static constexpr size_t offset = Offset;
+    static constexpr size_t width = bus_detail::ElementShape<Member>::width;
+
+    static_assert(DataTypeTraits<element>::known, "Bus fields must be numeric scalars or arrays; nested buses are not supported");
+    static_assert(sizeof(Member) == width * sizeof(element), "Bus field arrays must not be padded");
+};
+
+#define SFU_BUS_FIELD(Struct, member) BusField<decltype(Struct::member), offsetof(Struct, member)>
+
+/**
+ * Layout of a Simulink bus as a C++ struct, one field per bus element in
+ * the order of the bus object:
+ *
+ *   struct Pose
+ *   {
+ *       real_T position[3];
+ *       real32_T heading;
+ *       boolean_T valid;
+ *   };
+ *
+ *   using PoseBus = BusLayout<Pose,
+ *       SFU_BUS_FIELD(Pose, position),
+ *       SFU_BUS_FIELD(Pose, heading),
+ *       SFU_BUS_FIELD(Pose, valid)>;
+ *
+ * The offsets are compile-time constants (offsetof). Validate() compares
+ * them, the element data types and widths and the struct size with the
+ * bus registered in Simulink, so a port buffer of that bus can be used as
+ * the struct directly.
+ */
+template <typename Struct, typename... Fields>
+struct BusLayout
+{
+    using type = Struct;
+    static constexpr size_t fieldCount = sizeof...(Fields);
+
+    static_assert(sizeof...(Fields) > 0, "BusLayout needs at least one field");
+    static_assert(std::is_standard_layout_v<Struct> && std::is_trivially_copyable_v<Struct>,
+                  "Bus structs must be plain C structs");
+    static_assert(bus_detail::OffsetsAscending<Fields...>(), "Bus fields must be listed in declaration order");
+    static_assert(((Fields::offset + sizeof(typename Fields::type) <= sizeof(Struct)) && ...), "Bus field lies outside of the struct");
+
+    /** Check that data type busType matches this layout; sets the error status otherwise. */
+    static bool Validate(SimStruct *S, DTypeId busType)
+    {
+        if (!ssIsDataTypeABus(S, busType))
+        {
+            SetErrorStatusf(S, "Data type %d is not a bus", (int)busType);
+            return false;
+        }
+        if ((size_t)ssGetDataTypeSize(S, busType) != sizeof(Struct))
+        {
+            SetErrorStatusf(S, "Bus data type %d has %d bytes, but the struct has %zu", (int)busType, (int)ssGetDataTypeSize(S, busType), sizeof(Struct));
+            return false;
+        }
+        if ((size_t)ssGetNumBusElements(S, busType) != fieldCount)
+        {
+            SetErrorStatusf(S, "Bus data type %d has %d elements, but the struct layout has %zu", (int)busType, (int)ssGetNumBusElements(S, busType), fieldCount);
+            return false;
+        }
+        int_T index = 0;
+        return (ValidateField<Fields>(S, busType, index++) && ...);
+    }
+
+private:
+    template <typename Field>
+    static bool ValidateField(SimStruct *S, DTypeId busType, int_T index)
+    {
+        const char *name = ssGetBusElementName(S, busType, index);
+        if ((size_t)ssGetBusElementOffset(S, busType, index) != Field::offset)
+        {
+            SetErrorStatusf(S, "Bus element %d (%s) is at offset %d, but the struct field at offset %zu", (int)index, name, (int)ssGetBusElementOffset(S, busType, index), Field::offset);
+            return false;
+        }
+        if (!bus_detail::MatchesDataType<typename Field::element>(ssGetBusElementDataType(S, busType, index)))
+        {
+            SetErrorStatusf(S, "Bus element %d (%s) has data type %d, but the struct field has data type %d", (int)index, name, (int)ssGetBusElementDataType(S, busType, index), (int)DataTypeTraits<typename Field::element>::id);
+            return false;
+        }
+        size_t width = 1;
+        const int_T *dims = ssGetBusElementDimensions(S, busType, index);
+        for (int_T d = 0; d < ssGetBusElementNumDimensions(S, busType, index); ++d)
+            width *= (size_t)dims[d];
+        if (width != Field::width)
+        {
+            SetErrorStatusf(S, "Bus element %d (%s) has %zu elements, but the struct field has %zu", (int)index, name, width, Field::width);
+            return false;
+        }
+        return true;
+    }
+};
+
+/**
+ * Define input port portIndex as a bus of bus object busName, passed to
+ * the block as a struct (call in mdlInitializeSizes).
+ */
+inline bool DefineBusInputPort(SimStruct *S, int portIndex, const char *busName, int isDirectFeedthrough = 0)
+{
+    DTypeId busType = DYNAMICALLY_TYPED;
+    // The bus object may not exist when Simulink only queries the sizes
+    if (ssGetSimMode(S) != SS_SIMMODE_SIZES_CALL_ONLY)
+    {
+        ssRegisterTypeFromNamedObject(S, busName, &busType);
+        if (busType == INVALID_DTYPE_ID)
+        {
+            SetErrorStatusf(S, "Bus object %s for input port %d does not exist", busName, portIndex);
+            return false;
+        }
+    }
+    DefineTypedInputPort(S, portIndex, busType, 1, 1, isDirectFeedthrough);
+    if (ssGetNumInputPorts(S) <= portIndex)
+        return false;
+
+    ssSetBusInputAsStruct(S, portIndex, 1);
+    ssSetInputPortBusMode(S, portIndex, SL_BUS_MODE);
+    return true;
+}
+
+/** Define output port portIndex as a bus of bus object busName, see DefineBusInputPort(). */
+inline bool DefineBusOutputPort(SimStruct *S, int portIndex, const char *busName)
+{
+    DTypeId busType = DYNAMICALLY_TYPED;
+    if (ssGetSimMode(S) != SS_SIMMODE_SIZES_CALL_ONLY)
+    {
+        ssRegisterTypeFromNamedObject(S, busName, &busType);
+        if (busType == INVALID_DTYPE_ID)
+        {
+            SetErrorStatusf(S, "Bus object %s for output port %d does not exist", busName, portIndex);
+            return false;
+        }
+    }
+    DefineTypedOutputPort(S, portIndex, busType, 1, 1);
+    if (ssGetNumOutputPorts(S) <= portIndex)
+        return false;
+
+    ssSetBusOutputObjectName(S, portIndex, (void *)busName);
+    ssSetBusOutputAsStruct(S, portIndex, 1);
+    ssSetOutputPortBusMode(S, portIndex, SL_BUS_MODE);
+    return true;
+}
+
+/**
+ * Check that input port portIndex carries a bus matching Layout, as a
+ * contiguous, suitably aligned struct. Call once in mdlSetWorkWidths.
+ */
+template <typename Layout>
+bool ValidateBusInputPort(SimStruct *S, int portIndex)
+{
+    if (ssGetNumInputPorts(S) <= portIndex)
+    {
+        SetErrorStatusf(S, "Insufficient number of input ports configured for Port %d", portIndex);
+        return false;
+    }
+    if (ssGetInputPortWidth(S, portIndex) != 1 || !ssGetInputPortRequiredContiguous(S, portIndex))
+    {
+        SetErrorStatusf(S, "Input port %d must be a single contiguous bus, check DefineBusInputPort()", portIndex);
+        return false;
+    }
+    if (!Layout::Validate(S, ssGetInputPortDataType(S, portIndex)))
+        return false;
+    const void *signal = ssGetInputPortSignal(S, portIndex);
+    if (signal && (uintptr_t)signal % alignof(typename Layout::type) != 0)
+    {
+        SetErrorStatusf(S, "Input port %d bus buffer is not aligned for the struct", portIndex);
+        return false;
+    }
+    return true;
+}
+
+/** Check that output port portIndex carries a bus matching Layout, see ValidateBusInputPort(). */
+template <typename Layout>
+bool ValidateBusOutputPort(SimStruct *S, int portIndex)
+{
+    if (ssGetNumOutputPorts(S) <= portIndex)
+    {
+        SetErrorStatusf(S, "Insufficient number of output ports configured for Port %d", portIndex);
+        return false;
+    }
+    if (ssGetOutputPortWidth(S, portIndex) != 1)
+    {
+        SetErrorStatusf(S, "Output port %d must be a single bus, check DefineBusOutputPort()", portIndex);
+        return false;
+    }
+    if (!Layout::Validate(S, ssGetOutputPortDataType(S, portIndex)))
+        return false;
+    const void *signal = ssGetOutputPortSignal(S, portIndex);
+    if (signal && (uintptr_t)signal % alignof(typename Layout::type) != 0)
+    {
+        SetErrorStatusf(S, "Output port %d bus buffer is not aligned for the struct", portIndex);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * The bus on input port portIndex as a struct, without copying. Validate
+ * the port once with ValidateBusInputPort(); like PortTable, this only
+ * re-validates when SFU_PORT_TABLE_CHECKED is enabled.
+ */
+template <typename Layout>
+const typename Layout::type *GetBusInputPort(SimStruct *S, int portIndex)
+{
+    SFU_INSTRUMENT(S, InputPorts);
+#if SFU_PORT_TABLE_CHECKED
+    if (!ValidateBusInputPort<Layout>(S, portIndex))
+        return nullptr;
+#endif
+    return static_cast<const typename Layout::type *>(ssGetInputPortSignal(S, portIndex));
+}
+
+/** The bus on output port portIndex as a struct, written in place; see GetBusInputPort(). */
+template <typename Layout>
+typename Layout::type *GetBusOutputPort(SimStruct *S, int portIndex)
+{
+    SFU_INSTRUMENT(S, OutputPorts);
+#if SFU_PORT_TABLE_CHECKED
+    if (!ValidateBusOutputPort<Layout>(S, portIndex))
+        return nullptr;
+#endif
+    return static_cast<typename Layout::type *>(ssGetOutputPortSignal(S, portIndex));
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "IO.hpp"
+#include "Parameters.hpp"
+#include <complex>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+
+/*
+ * Complex ports and parameters as std::complex<T>, where T is the real
+ * element type (real_T, real32_T, ...):
+ *
+ *   DefineComplexInputPort<real_T>(S, 0, 1024, 1, 1); // mdlInitializeSizes
+ *
+ *   auto iq = GetComplexInputPortView<real_T>(S, 0, 1024); // mdlOutputs
+ *   for (const std::complex<real_T> &sample : *iq)
+ *       ...
+ *
+ * Simulink stores complex signals with real and imaginary part interleaved,
+ * which is the layout of std::complex<T>, so the views point directly into
+ * the port buffer. Complex parameters need the interleaved complex API
+ * (mex -R2018a, which defines MX_HAS_INTERLEAVED_COMPLEX); with separate
+ * real and imaginary arrays a view without copying is not possible.
+ *
+ * The views are limited to real_T and real32_T: std::complex is only
+ * specified for floating point types. Complex integer ports can still be
+ * defined with DefineComplexInputPort/DefineComplexOutputPort.
+ */
+
+/** Define a complex input port of rows x cols elements of std::complex<T>. */
+template <typename T>
+void DefineComplexInputPort(SimStruct *S, int portIndex, int rows = 1, int cols = 1, int isDirectFeedthrough = 0)
+{
+    DefineInputPort<T>(S, portIndex, rows, cols, isDirectFeedthrough);
+    if (ssGetNumInputPorts(S) <= portIndex)
+        return;
+
+    ssSetInputPortComplexSignal(S, portIndex, COMPLEX_YES);
+}
+
+/** Define a complex output port of rows x cols elements of std::complex<T>. */
+template <typename T>
+void DefineComplexOutputPort(SimStruct *S, int portIndex, int rows = 1, int cols = 1)
+{
+    DefineOutputPort<T>(S, portIndex, rows, cols);
+    if (ssGetNumOutputPorts(S) <= portIndex)
+        return;
+
+    ssSetOutputPortComplexSignal(S, portIndex, COMPLEX_YES);
+}
+
+namespace complex_detail
+{
+    // std::complex<T> is unspecified for anything but float, double and long double
+    template <typename T>
+    constexpr bool IsViewable = std::is_same_v<T, real_T> || std::is_same_v<T, real32_T>;
+
+    template <typename T>
+    constexpr bool HasInterleavedLayout = sizeof(std::complex<T>) == 2 * sizeof(T) && alignof(std::complex<T>) == alignof(T);
+
+    template <typename T>
+    const std::complex<T> *InputSignal(SimStruct *S, int portIndex, size_t size)
+    {
+        static_assert(IsViewable<T>, "Complex views need T = real_T or real32_T");
+        static_assert(HasInterleavedLayout<T>, "std::complex<T> must have the layout of T[2]");
+        if (ssGetNumInputPorts(S) > portIndex && ssGetInputPortComplexSignal(S, portIndex) != COMPLEX_YES)
+        {
+            SetErrorStatusf(S, "Input port %d is not complex, check DefineComplexInputPort()", portIndex);
+            return nullptr;
+        }
+        return reinterpret_cast<const std::complex<T> *>(GetInputPortSignal<T>(S, portIndex, size));
+    }
+
+    template <typename T>
+    std::complex<T> *OutputSignal(SimStruct *S, int portIndex, size_t size)
+    {
+        static_assert(IsViewable<T>, "Complex views need T = real_T or real32_T");
+        static_assert(HasInterleavedLayout<T>, "std::complex<T> must have the layout of T[2]");
+        if (ssGetNumOutputPorts(S) > portIndex && ssGetOutputPortComplexSignal(S, portIndex) != COMPLEX_YES)
+        {
+            SetErrorStatusf(S, "Output port %d is not complex, check DefineComplexOutputPort()", portIndex);
+            return nullptr;
+        }
+        return reinterpret_cast<std::complex<T> *>(GetOutputPortSignal<T>(S, portIndex, size));
+    }
+
+#if MX_HAS_INTERLEAVED_COMPLEX
+    // Interleaved data of a complex mxArray of the class of T
+    template <typename T>
+    const void *InterleavedData(const mxArray *param)
+    {
+        if constexpr (std::is_same_v<T, double>)
+            return mxGetComplexDoubles(param);
+        else
+            return mxGetComplexSingles(param);
+    }
+#endif
+}
+
+/** View over a complex vector input port of width elements. */
+template <typename T>
+std::optional<InputPortView<std::complex<T>>> GetComplexInputPortView(SimStruct *S, int portIndex, size_t width)
+{
+    SFU_INSTRUMENT(S, InputPorts);
+    const std::complex<T> *inputSignal = complex_detail::InputSignal<T>(S, portIndex, width);
+    if (!inputSignal)
+        return std::nullopt;
+
+    return InputPortView<std::complex<T>>(inputSignal, width);
+}
+
+/** View over a complex rows x cols input port (column-major). */
+template <typename T>
+std::optional<InputMatrixView<std::complex<T>>> GetComplexInputMatrixView(SimStruct *S, int portIndex, size_t rows, size_t cols)
+{
+    SFU_INSTRUMENT(S, InputPorts);
+    const std::complex<T> *inputSignal = complex_detail::InputSignal<T>(S, portIndex, rows * cols);
+    if (!inputSignal)
+        return std::nullopt;
+
+    return InputMatrixView<std::complex<T>>(inputSignal, rows, cols);
+}
+
+/** Writable view over a complex vector output port of width elements. */
+template <typename T>
+std::optional<OutputPortView<std::complex<T>>> GetComplexOutputPortView(SimStruct *S, int portIndex, size_t width)
+{
+    SFU_INSTRUMENT(S, OutputPorts);
+    std::complex<T> *outputSignal = complex_detail::OutputSignal<T>(S, portIndex, width);
+    if (!outputSignal)
+        return std::nullopt;
+
+    return OutputPortView<std::complex<T>>(outputSignal, width);
+}
+
+/** Writable view over a complex rows x cols output port (column-major). */
+template <typename T>
+std::optional<OutputMatrixView<std::complex<T>>> GetComplexOutputMatrixView(SimStruct *S, int portIndex, size_t rows, size_t cols)
+{
+    SFU_INSTRUMENT(S, OutputPorts);
+    std::complex<T> *outputSignal = complex_detail::OutputSignal<T>(S, portIndex, rows * cols);
+    if (!outputSignal)
+        return std::nullopt;
+
+    return OutputMatrixView<std::complex<T>>(outputSignal, rows, cols);
+}
+
+/**
+ * Zero-copy view of a complex double or single parameter whose MATLAB class
+ * matches T exactly, e.g. ParamView<std::complex<double>> for a complex
+ * double parameter. Real parameters are rejected.
+ */
+template <typename T>
+std::optional<ParamView<std::complex<T>>> extractSFunctionParameterComplexView(SimStruct *S, int paramIndex)
+{
+    SFU_INSTRUMENT(S, Parameters);
+    static_assert(std::is_same_v<T, double> || std::is_same_v<T, float>, "Complex parameter views need T = double or float");
+
+    const mxArray *param = getSFunctionParameterChecked(S, paramIndex);
+    if (param == nullptr)
+        return std::nullopt;
+    if (mxGetClassID(param) != mxClassIdOf<T>() || !mxIsComplex(param))
+    {
+        SetErrorStatusf(S, "Parameter at index %d has class %s%s, which does not match the requested complex element type", paramIndex, mxIsComplex(param) ? "complex " : "", mxGetClassName(param));
+        return std::nullopt;
+    }
+#if MX_HAS_INTERLEAVED_COMPLEX
+    const size_t rows = mxGetM(param);
+    const size_t cols = rows ? mxGetNumberOfElements(param) / rows : 0;
+    return ParamView<std::complex<T>>(static_cast<const std::complex<T> *>(complex_detail::InterleavedData<T>(param)), rows, cols);
+#else
+    SetErrorStatusf(S, "Complex parameter at index %d needs the interleaved complex API, compile with mex -R2018a", paramIndex);
+    return std::nullopt;
+#endif
+}
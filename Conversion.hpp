@@ -0,0 +1,550 @@
+#pragma once
+
+#include "IO.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+/*
+ * Type-converting port copies, e.g. a uint8_T sensor port into a real32_T
+ * buffer and back with saturation:
+ *
+ *   float samples[64];
+ *   GetInputPortConverted<uint8_T>(S, 0, samples, 64, 1.0 / 255.0);
+ *   ...
+ *   SetVectorOutputPortConverted<uint8_T>(S, 0, samples, 64, 255.0);
+ *
+ * Every element is computed as value * scale + offset. Conversions to an
+ * integer type round to nearest (ties to even), saturate to the range of the
+ * type and map NaN to 0.
+ *
+ * The conversions between 8/16-bit integers and float/double have SSE2,
+ * AVX2 and NEON kernels. The kernel is chosen once per type pair by runtime
+ * CPU feature detection; all other pairs use the scalar kernel. Define
+ * SFU_CONVERSION_FORCE_SCALAR to disable the vector kernels.
+ */
+
+#if !defined(SFU_CONVERSION_FORCE_SCALAR)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SFU_CONVERSION_SSE2 1
+#define SFU_CONVERSION_AVX2 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define SFU_CONVERSION_NEON 1
+#include <arm_neon.h>
+#endif
+#endif
+
+#if defined(SFU_CONVERSION_AVX2) && (defined(__GNUC__) || defined(__clang__))
+#define SFU_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SFU_TARGET_AVX2
+#endif
+
+enum class ConversionInstructionSet
+{
+    Scalar,
+    SSE2,
+    AVX2,
+    NEON
+};
+
+inline const char *ConversionInstructionSetName(ConversionInstructionSet instructionSet)
+{
+    switch (instructionSet)
+    {
+    case ConversionInstructionSet::SSE2:
+        return "SSE2";
+    case ConversionInstructionSet::AVX2:
+        return "AVX2";
+    case ConversionInstructionSet::NEON:
+        return "NEON";
+    default:
+        return "scalar";
+    }
+}
+
+/** Best instruction set for the vector kernels on this CPU, detected once. */
+inline ConversionInstructionSet DetectConversionInstructionSet()
+{
+    static const ConversionInstructionSet detected = []
+    {
+#if defined(SFU_CONVERSION_AVX2) && (defined(__GNUC__) || defined(__clang__))
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return ConversionInstructionSet::AVX2;
+#elif defined(SFU_CONVERSION_AVX2) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] >= 7)
+        {
+            __cpuid(info, 1);
+            const bool osSavesAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+            __cpuidex(info, 7, 0);
+            if (osSavesAvx && (info[1] & (1 << 5)))
+                return ConversionInstructionSet::AVX2;
+        }
+#endif
+#if defined(SFU_CONVERSION_SSE2)
+        return ConversionInstructionSet::SSE2;
+#elif defined(SFU_CONVERSION_NEON)
+        return ConversionInstructionSet::NEON;
+#else
+        return ConversionInstructionSet::Scalar;
+#endif
+    }();
+    return detected;
+}
+
+namespace conversion_detail
+{
+    // Arithmetic is done in double if either side is double, in float otherwise
+    template <typename Source, typename Dest>
+    using Compute = std::conditional_t<std::is_same_v<Source, double> || std::is_same_v<Dest, double>, double, float>;
+
+    template <typename T>
+    constexpr bool IsSmallInteger = std::is_same_v<T, uint8_T> || std::is_same_v<T, int8_T> ||
+                                    std::is_same_v<T, uint16_T> || std::is_same_v<T, int16_T>;
+
+    template <typename T>
+    constexpr bool IsFloat = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+    // Pairs with vector kernels: small integer to float/double and back
+    template <typename Source, typename Dest>
+    constexpr bool IsWidening = IsSmallInteger<Source> && IsFloat<Dest>;
+    template <typename Source, typename Dest>
+    constexpr bool IsNarrowing = IsFloat<Source> && IsSmallInteger<Dest>;
+
+    template <typename Source, typename Dest>
+    using Kernel = void (*)(const Source *, Dest *, size_t, Compute<Source, Dest>, Compute<Source, Dest>);
+
+    template <typename Dest, typename C>
+    inline Dest SaturateCast(C value)
+    {
+        if constexpr (std::is_floating_point_v<Dest>)
+            return static_cast<Dest>(value);
+        else
+        {
+            if (value != value)
+                return 0;
+            constexpr C lowest = static_cast<C>(std::numeric_limits<Dest>::min());
+            constexpr C highest = static_cast<C>(std::numeric_limits<Dest>::max());
+            if (value <= lowest)
+                return std::numeric_limits<Dest>::min();
+            if (value >= highest)
+                return std::numeric_limits<Dest>::max();
+            return static_cast<Dest>(std::nearbyint(value));
+        }
+    }
+
+    // Reference kernel; the vector kernels produce the same results
+    template <typename Source, typename Dest>
+    void ConvertScalar(const Source *source, Dest *dest, size_t count, Compute<Source, Dest> scale, Compute<Source, Dest> offset)
+    {
+        typedef Compute<Source, Dest> C;
+        for (size_t i = 0; i < count; ++i)
+            dest[i] = SaturateCast<Dest>(static_cast<C>(source[i]) * scale + offset);
+    }
+
+#if defined(SFU_CONVERSION_SSE2)
+    /* SSE2: 4 elements per step */
+
+    template <typename Source>
+    inline __m128 LoadFloat4Sse2(const Source *source)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i v;
+        if constexpr (sizeof(Source) == 1)
+        {
+            int32_t bytes;
+            std::memcpy(&bytes, source, sizeof(bytes));
+            v = _mm_cvtsi32_si128(bytes);
+            if constexpr (std::is_signed_v<Source>)
+                v = _mm_srai_epi32(_mm_unpacklo_epi16(_mm_unpacklo_epi8(v, v), _mm_unpacklo_epi8(v, v)), 24);
+            else
+                v = _mm_unpacklo_epi16(_mm_unpacklo_epi8(v, zero), zero);
+        }
+        else
+        {
+            v = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(source));
+            if constexpr (std::is_signed_v<Source>)
+                v = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+            else
+                v = _mm_unpacklo_epi16(v, zero);
+        }
+        return _mm_cvtepi32_ps(v);
+    }
+
+    // v holds 4 int32 already saturated to the range of Dest
+    template <typename Dest>
+    inline void StoreInt4Sse2(Dest *dest, __m128i v)
+    {
+        if constexpr (std::is_same_v<Dest, int16_T>)
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dest), _mm_packs_epi32(v, v));
+        else if constexpr (std::is_same_v<Dest, uint16_T>)
+        {
+            // SSE2 has no unsigned 32 -> 16 bit pack: bias into the signed range and back
+            v = _mm_packs_epi32(_mm_sub_epi32(v, _mm_set1_epi32(32768)), _mm_setzero_si128());
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dest), _mm_xor_si128(v, _mm_set1_epi16(-32768)));
+        }
+        else
+        {
+            v = _mm_packs_epi32(v, v);
+            v = std::is_signed_v<Dest> ? _mm_packs_epi16(v, v) : _mm_packus_epi16(v, v);
+            const int32_t bytes = _mm_cvtsi128_si32(v);
+            std::memcpy(dest, &bytes, sizeof(bytes));
+        }
+    }
+
+    template <typename Source, typename Dest>
+    void ConvertSse2(const Source *source, Dest *dest, size_t count, Compute<Source, Dest> scale, Compute<Source, Dest> offset)
+    {
+        size_t i = 0;
+        if constexpr (IsWidening<Source, Dest> && std::is_same_v<Dest, float>)
+        {
+            const __m128 s = _mm_set1_ps(scale), o = _mm_set1_ps(offset);
+            for (; i + 4 <= count; i += 4)
+                _mm_storeu_ps(dest + i, _mm_add_ps(_mm_mul_ps(LoadFloat4Sse2(source + i), s), o));
+        }
+        else if constexpr (IsWidening<Source, Dest>)
+        {
+            const __m128d s = _mm_set1_pd(scale), o = _mm_set1_pd(offset);
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128 v = LoadFloat4Sse2(source + i);
+                _mm_storeu_pd(dest + i, _mm_add_pd(_mm_mul_pd(_mm_cvtps_pd(v), s), o));
+                _mm_storeu_pd(dest + i + 2, _mm_add_pd(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(v, v)), s), o));
+            }
+        }
+        else if constexpr (IsNarrowing<Source, Dest> && std::is_same_v<Source, float>)
+        {
+            const __m128 s = _mm_set1_ps(scale), o = _mm_set1_ps(offset);
+            const __m128 lowest = _mm_set1_ps(std::numeric_limits<Dest>::min());
+            const __m128 highest = _mm_set1_ps(std::numeric_limits<Dest>::max());
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128 v = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(source + i), s), o);
+                v = _mm_and_ps(v, _mm_cmpord_ps(v, v));
+                v = _mm_min_ps(_mm_max_ps(v, lowest), highest);
+                StoreInt4Sse2(dest + i, _mm_cvtps_epi32(v));
+            }
+        }
+        else if constexpr (IsNarrowing<Source, Dest>)
+        {
+            const __m128d s = _mm_set1_pd(scale), o = _mm_set1_pd(offset);
+            const __m128d lowest = _mm_set1_pd(std::numeric_limits<Dest>::min());
+            const __m128d highest = _mm_set1_pd(std::numeric_limits<Dest>::max());
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128d a = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(source + i), s), o);
+                __m128d b = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(source + i + 2), s), o);
+                a = _mm_min_pd(_mm_max_pd(_mm_and_pd(a, _mm_cmpord_pd(a, a)), lowest), highest);
+                b = _mm_min_pd(_mm_max_pd(_mm_and_pd(b, _mm_cmpord_pd(b, b)), lowest), highest);
+                StoreInt4Sse2(dest + i, _mm_unpacklo_epi64(_mm_cvtpd_epi32(a), _mm_cvtpd_epi32(b)));
+            }
+        }
+        ConvertScalar(source + i, dest + i, count - i, scale, offset);
+    }
+#endif
+
+#if defined(SFU_CONVERSION_AVX2)
+    /* AVX2: 8 elements per step */
+
+    template <typename Source>
+    SFU_TARGET_AVX2 inline __m256 LoadFloat8Avx2(const Source *source)
+    {
+        __m256i v;
+        if constexpr (std::is_same_v<Source, uint8_T>)
+            v = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(source)));
+        else if constexpr (std::is_same_v<Source, int8_T>)
+            v = _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(source)));
+        else if constexpr (std::is_same_v<Source, uint16_T>)
+            v = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(source)));
+        else
+            v = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(source)));
+        return _mm256_cvtepi32_ps(v);
+    }
+
+    // low and high hold 4 int32 each, already saturated to the range of Dest
+    template <typename Dest>
+    SFU_TARGET_AVX2 inline void StoreInt8Avx2(Dest *dest, __m128i low, __m128i high)
+    {
+        if constexpr (std::is_same_v<Dest, int16_T>)
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest), _mm_packs_epi32(low, high));
+        else if constexpr (std::is_same_v<Dest, uint16_T>)
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest), _mm_packus_epi32(low, high));
+        else
+        {
+            const __m128i v = _mm_packs_epi32(low, high);
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dest), std::is_signed_v<Dest> ? _mm_packs_epi16(v, v) : _mm_packus_epi16(v, v));
+        }
+    }
+
+    template <typename Source, typename Dest>
+    SFU_TARGET_AVX2 void ConvertAvx2(const Source *source, Dest *dest, size_t count, Compute<Source, Dest> scale, Compute<Source, Dest> offset)
+    {
+        size_t i = 0;
+        if constexpr (IsWidening<Source, Dest> && std::is_same_v<Dest, float>)
+        {
+            const __m256 s = _mm256_set1_ps(scale), o = _mm256_set1_ps(offset);
+            for (; i + 8 <= count; i += 8)
+                _mm256_storeu_ps(dest + i, _mm256_add_ps(_mm256_mul_ps(LoadFloat8Avx2(source + i), s), o));
+        }
+        else if constexpr (IsWidening<Source, Dest>)
+        {
+            const __m256d s = _mm256_set1_pd(scale), o = _mm256_set1_pd(offset);
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256 v = LoadFloat8Avx2(source + i);
+                _mm256_storeu_pd(dest + i, _mm256_add_pd(_mm256_mul_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(v)), s), o));
+                _mm256_storeu_pd(dest + i + 4, _mm256_add_pd(_mm256_mul_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)), s), o));
+            }
+        }
+        else if constexpr (IsNarrowing<Source, Dest> && std::is_same_v<Source, float>)
+        {
+            const __m256 s = _mm256_set1_ps(scale), o = _mm256_set1_ps(offset);
+            const __m256 lowest = _mm256_set1_ps(std::numeric_limits<Dest>::min());
+            const __m256 highest = _mm256_set1_ps(std::numeric_limits<Dest>::max());
+            for (; i + 8 <= count; i += 8)
+            {
+                __m256 v = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(source + i), s), o);
+                v = _mm256_and_ps(v, _mm256_cmp_ps(v, v, _CMP_ORD_Q));
+                v = _mm256_min_ps(_mm256_max_ps(v, lowest), highest);
+                const __m256i converted = _mm256_cvtps_epi32(v);
+                StoreInt8Avx2(dest + i, _mm256_castsi256_si128(converted), _mm256_extracti128_si256(converted, 1));
+            }
+        }
+        else if constexpr (IsNarrowing<Source, Dest>)
+        {
+            const __m256d s = _mm256_set1_pd(scale), o = _mm256_set1_pd(offset);
+            const __m256d lowest = _mm256_set1_pd(std::numeric_limits<Dest>::min());
+            const __m256d highest = _mm256_set1_pd(std::numeric_limits<Dest>::max());
+            for (; i + 8 <= count; i += 8)
+            {
+                __m256d a = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(source + i), s), o);
+                __m256d b = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(source + i + 4), s), o);
+                a = _mm256_min_pd(_mm256_max_pd(_mm256_and_pd(a, _mm256_cmp_pd(a, a, _CMP_ORD_Q)), lowest), highest);
+                b = _mm256_min_pd(_mm256_max_pd(_mm256_and_pd(b, _mm256_cmp_pd(b, b, _CMP_ORD_Q)), lowest), highest);
+                StoreInt8Avx2(dest + i, _mm256_cvtpd_epi32(a), _mm256_cvtpd_epi32(b));
+            }
+        }
+        ConvertScalar(source + i, dest + i, count - i, scale, offset);
+    }
+#endif
+
+#if defined(SFU_CONVERSION_NEON)
+    /* NEON (AArch64): 8 elements per step */
+
+    template <typename Source>
+    inline void LoadFloat8Neon(const Source *source, float32x4_t &low, float32x4_t &high)
+    {
+        if constexpr (std::is_signed_v<Source>)
+        {
+            int16x8_t v;
+            if constexpr (sizeof(Source) == 1)
+                v = vmovl_s8(vld1_s8(source));
+            else
+                v = vld1q_s16(source);
+            low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+            high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+        }
+        else
+        {
+            uint16x8_t v;
+            if constexpr (sizeof(Source) == 1)
+                v = vmovl_u8(vld1_u8(source));
+            else
+                v = vld1q_u16(source);
+            low = vcvtq_f32_u32(vmovl_u16(vget_low_u16(v)));
+            high = vcvtq_f32_u32(vmovl_u16(vget_high_u16(v)));
+        }
+    }
+
+    // low and high hold 4 int32 each, already saturated to the range of Dest
+    template <typename Dest>
+    inline void StoreInt8Neon(Dest *dest, int32x4_t low, int32x4_t high)
+    {
+        if constexpr (std::is_same_v<Dest, int16_T>)
+            vst1q_s16(dest, vcombine_s16(vmovn_s32(low), vmovn_s32(high)));
+        else if constexpr (std::is_same_v<Dest, uint16_T>)
+            vst1q_u16(dest, vcombine_u16(vqmovun_s32(low), vqmovun_s32(high)));
+        else if constexpr (std::is_same_v<Dest, int8_T>)
+            vst1_s8(dest, vmovn_s16(vcombine_s16(vmovn_s32(low), vmovn_s32(high))));
+        else
+            vst1_u8(dest, vqmovun_s16(vcombine_s16(vmovn_s32(low), vmovn_s32(high))));
+    }
+
+    inline float32x4_t SaturateNeon(float32x4_t v, float32x4_t lowest, float32x4_t highest)
+    {
+        v = vbslq_f32(vceqq_f32(v, v), v, vdupq_n_f32(0.0f));
+        return vminq_f32(vmaxq_f32(v, lowest), highest);
+    }
+
+    inline float64x2_t SaturateNeon(float64x2_t v, float64x2_t lowest, float64x2_t highest)
+    {
+        v = vbslq_f64(vceqq_f64(v, v), v, vdupq_n_f64(0.0));
+        return vminq_f64(vmaxq_f64(v, lowest), highest);
+    }
+
+    template <typename Source, typename Dest>
+    void ConvertNeon(const Source *source, Dest *dest, size_t count, Compute<Source, Dest> scale, Compute<Source, Dest> offset)
+    {
+        size_t i = 0;
+        if constexpr (IsWidening<Source, Dest> && std::is_same_v<Dest, float>)
+        {
+            const float32x4_t s = vdupq_n_f32(scale), o = vdupq_n_f32(offset);
+            for (; i + 8 <= count; i += 8)
+            {
+                float32x4_t low, high;
+                LoadFloat8Neon(source + i, low, high);
+                vst1q_f32(dest + i, vaddq_f32(vmulq_f32(low, s), o));
+                vst1q_f32(dest + i + 4, vaddq_f32(vmulq_f32(high, s), o));
+            }
+        }
+        else if constexpr (IsWidening<Source, Dest>)
+        {
+            const float64x2_t s = vdupq_n_f64(scale), o = vdupq_n_f64(offset);
+            for (; i + 8 <= count; i += 8)
+            {
+                float32x4_t low, high;
+                LoadFloat8Neon(source + i, low, high);
+                vst1q_f64(dest + i, vaddq_f64(vmulq_f64(vcvt_f64_f32(vget_low_f32(low)), s), o));
+                vst1q_f64(dest + i + 2, vaddq_f64(vmulq_f64(vcvt_high_f64_f32(low), s), o));
+                vst1q_f64(dest + i + 4, vaddq_f64(vmulq_f64(vcvt_f64_f32(vget_low_f32(high)), s), o));
+                vst1q_f64(dest + i + 6, vaddq_f64(vmulq_f64(vcvt_high_f64_f32(high), s), o));
+            }
+        }
+        else if constexpr (IsNarrowing<Source, Dest> && std::is_same_v<Source, float>)
+        {
+            const float32x4_t s = vdupq_n_f32(scale), o = vdupq_n_f32(offset);
+            const float32x4_t lowest = vdupq_n_f32(std::numeric_limits<Dest>::min());
+            const float32x4_t highest = vdupq_n_f32(std::numeric_limits<Dest>::max());
+            for (; i + 8 <= count; i += 8)
+            {
+                const float32x4_t low = SaturateNeon(vaddq_f32(vmulq_f32(vld1q_f32(source + i), s), o), lowest, highest);
+                const float32x4_t high = SaturateNeon(vaddq_f32(vmulq_f32(vld1q_f32(source + i + 4), s), o), lowest, highest);
+                StoreInt8Neon(dest + i, vcvtnq_s32_f32(low), vcvtnq_s32_f32(high));
+            }
+        }
+        else if constexpr (IsNarrowing<Source, Dest>)
+        {
+            const float64x2_t s = vdupq_n_f64(scale), o = vdupq_n_f64(offset);
+            const float64x2_t lowest = vdupq_n_f64(std::numeric_limits<Dest>::min());
+            const float64x2_t highest = vdupq_n_f64(std::numeric_limits<Dest>::max());
+            int32x2_t parts[4];
+            for (; i + 8 <= count; i += 8)
+            {
+                for (size_t part = 0; part < 4; ++part)
+                {
+                    const float64x2_t v = vaddq_f64(vmulq_f64(vld1q_f64(source + i + 2 * part), s), o);
+                    parts[part] = vmovn_s64(vcvtnq_s64_f64(SaturateNeon(v, lowest, highest)));
+                }
+                StoreInt8Neon(dest + i, vcombine_s32(parts[0], parts[1]), vcombine_s32(parts[2], parts[3]));
+            }
+        }
+        ConvertScalar(source + i, dest + i, count - i, scale, offset);
+    }
+#endif
+
+    template <typename Source, typename Dest>
+    Kernel<Source, Dest> SelectKernel(ConversionInstructionSet instructionSet)
+    {
+        (void)instructionSet;
+        if constexpr (IsWidening<Source, Dest> || IsNarrowing<Source, Dest>)
+        {
+            switch (instructionSet)
+            {
+#if defined(SFU_CONVERSION_AVX2)
+            case ConversionInstructionSet::AVX2:
+                return ConvertAvx2<Source, Dest>;
+#endif
+#if defined(SFU_CONVERSION_SSE2)
+            case ConversionInstructionSet::SSE2:
+                return ConvertSse2<Source, Dest>;
+#endif
+#if defined(SFU_CONVERSION_NEON)
+            case ConversionInstructionSet::NEON:
+                return ConvertNeon<Source, Dest>;
+#endif
+            default:
+                break;
+            }
+        }
+        return ConvertScalar<Source, Dest>;
+    }
+}
+
+/**
+ * dest[i] = source[i] * scale + offset for count elements, converted to Dest.
+ * Integer results are rounded to nearest and saturated, NaN becomes 0.
+ * At least one of Source and Dest must be float or double.
+ */
+template <typename Source, typename Dest>
+void ConvertSamples(const Source *source, Dest *dest, size_t count, double scale = 1.0, double offset = 0.0)
+{
+    static_assert(std::is_arithmetic_v<Source> && std::is_arithmetic_v<Dest> &&
+                      !std::is_same_v<Source, bool> && !std::is_same_v<Dest, bool>,
+                  "ConvertSamples() converts between numeric types");
+    static_assert(std::is_floating_point_v<Source> || std::is_floating_point_v<Dest>,
+                  "ConvertSamples() needs a floating point source or destination");
+    typedef conversion_detail::Compute<Source, Dest> C;
+
+    static const conversion_detail::Kernel<Source, Dest> kernel =
+        conversion_detail::SelectKernel<Source, Dest>(DetectConversionInstructionSet());
+    kernel(source, dest, count, static_cast<C>(scale), static_cast<C>(offset));
+}
+
+/**
+ * Like GetInputPort(), but the port has element type PortT and is converted
+ * to T while copying: output[i] = input[i] * scale + offset.
+ * Fails if the data type of the port is not PortT.
+ */
+template <typename PortT, typename T>
+bool GetInputPortConverted(SimStruct *S, int portIndex, T *output, size_t width, double scale = 1.0, double offset = 0.0)
+{
+    const PortT *inputSignal = GetInputPortSignal<PortT>(S, portIndex, width);
+    if (!inputSignal)
+        return false;
+
+    if (ssGetInputPortDataType(S, portIndex) != SimulinkDataTypeId<PortT>())
+    {
+        SetErrorStatusf(S, "Input port %d has data type %d, but data type %d was requested", portIndex, (int)ssGetInputPortDataType(S, portIndex), (int)SimulinkDataTypeId<PortT>());
+        return false;
+    }
+
+    ConvertSamples(inputSignal, output, width, scale, offset);
+    return true;
+}
+
+/**
+ * Like SetVectorOutputPort(), but the port has element type PortT and each
+ * value is converted while copying: output[i] = values[i] * scale + offset,
+ * rounded and saturated for integer ports.
+ */
+template <typename PortT, typename T>
+void SetVectorOutputPortConverted(SimStruct *S, int portIndex, const T *values, size_t size, double scale = 1.0, double offset = 0.0)
+{
+    PortT *outputSignal = GetOutputPortSignal<PortT>(S, portIndex, size);
+    if (!outputSignal)
+        return;
+
+    if (ssGetOutputPortDataType(S, portIndex) != SimulinkDataTypeId<PortT>())
+    {
+        SetErrorStatusf(S, "Output port %d has data type %d, but data type %d was requested", portIndex, (int)ssGetOutputPortDataType(S, portIndex), (int)SimulinkDataTypeId<PortT>());
+        return;
+    }
+
+    ConvertSamples(values, outputSignal, size, scale, offset);
+}
+
+template <typename PortT, typename T>
+void SetVectorOutputPortConverted(SimStruct *S, int portIndex, const std::vector<T> &values, double scale = 1.0, double offset = 0.0)
+{
+    SetVectorOutputPortConverted<PortT>(S, portIndex, values.data(), values.size(), scale, offset);
+}
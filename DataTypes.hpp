@@ -0,0 +1,255 @@
+#pragma once
+
+#include "simstruc.h"
+#include "ErrorStatus.hpp"
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+// SS_INT64 / SS_UINT64 are built-in data types in recent MATLAB releases; define as 0 for releases without them
+#ifndef SFU_HAVE_INT64_DTYPES
+#define SFU_HAVE_INT64_DTYPES 1
+#endif
+
+// Half precision (real16_T) is a registered data type. With 1, its header has to be included before
+// this one, and every DataTypeDispatch kernel is also instantiated for real16_T
+#ifndef SFU_HAVE_HALF_DTYPE
+#define SFU_HAVE_HALF_DTYPE 0
+#endif
+
+/** Passes a type through a visitor, see VisitDataType(). */
+template <typename T>
+struct DataTypeTag
+{
+    using type = T;
+};
+
+/**
+ * Simulink built-in data type of the C++ type T. Only specialized for types
+ * that have one; everything else has known == false.
+ */
+template <typename T>
+struct DataTypeTraits
+{
+    static constexpr bool known = false;
+};
+
+template <>
+struct DataTypeTraits<real_T>
+{
+    static constexpr bool known = true;
+    static constexpr DTypeId id = SS_DOUBLE;
+    static constexpr const char *name = "double";
+};
+
+template <>
+struct DataTypeTraits<real32_T>
+{
+    static constexpr bool known = true;
+    static constexpr DTypeId id = SS_SINGLE;
+    static constexpr const char *name = "single";
+};
+
+template <>
+struct DataTypeTraits<int8_T>
+{
+    static constexpr bool known = true;
+    static constexpr DTypeId id = SS_INT8;
+    static constexpr const char *name = "int8";
+};
+
+// Also boolean_T, which is the same type as uint8_T
+template <>
+struct DataTypeTraits<uint8_T>
+{
+    static constexpr bool known = true;
+    static constexpr DTypeId id = SS_UINT8;
+    static constexpr const char *name = "uint8";
+};
+
+template <>
+struct DataTypeTraits<char_T>
+{
+    static constexpr bool known = true;
+    static constexpr DTypeId id = SS_UINT8;
+    static constexpr const char *name = "uint8";
+};
+
+template <>
+struct DataTypeTraits<int16_T>
+{
+    static constexpr bool known = true;
+    static constexpr DTypeId id = SS_INT16;
+    static constexpr const char *name = "int16";
+};
+
+template <>
+struct DataTypeTraits<uint16_T>
+{
+    static constexpr bool known = true;
+    static constexpr DTypeId id = SS_UINT16;
+    static constexpr const char *name = "uint16";
+};
+
+template <>
+struct DataTypeTraits<int32_T>
+{
+    static constexpr bool known = true;
+    static constexpr DTypeId id = SS_INT32;
+    static constexpr const char *name = "int32";
+};
+
+template <>
+struct DataTypeTraits<uint32_T>
+{
+    static constexpr bool known = true;
+    static constexpr DTypeId id = SS_UINT32;
+    static constexpr const char *name = "uint32";
+};
+
+template <>
+struct DataTypeTraits<bool>
+{
+    static constexpr bool known = true;
+    static constexpr DTypeId id = SS_BOOLEAN;
+    static constexpr const char *name = "boolean";
+};
+
+#if SFU_HAVE_INT64_DTYPES
+template <>
+struct DataTypeTraits<int64_T>
+{
+    static constexpr bool known = true;
+    static constexpr DTypeId id = SS_INT64;
+    static constexpr const char *name = "int64";
+};
+
+template <>
+struct DataTypeTraits<uint64_T>
+{
+    static constexpr bool known = true;
+    static constexpr DTypeId id = SS_UINT64;
+    static constexpr const char *name = "uint64";
+};
+#endif
+
+/**
+ * The C++ type of every built-in data type, as dispatched by
+ * VisitDataType(). SS_BOOLEAN is visited as bool.
+ */
+using SimulinkBuiltInTypes = std::tuple<real_T, real32_T, int8_T, uint8_T, int16_T, uint16_T, int32_T, uint32_T, bool
+#if SFU_HAVE_INT64_DTYPES
+                                        , int64_T, uint64_T
+#endif
+                                        >;
+
+/**
+ * Simulink built-in data type ID corresponding to the C++ type T.
+ * Types without a built-in data type are a compile error.
+ */
+template <typename T>
+constexpr DTypeId SimulinkDataTypeId()
+{
+    static_assert(DataTypeTraits<T>::known, "No Simulink built-in data type for this type, see DataTypeTraits");
+    return DataTypeTraits<T>::id;
+}
+
+/**
+ * Data type ID for ports of type T. Same as SimulinkDataTypeId<T>(), but
+ * also registers the half precision type for real16_T.
+ */
+template <typename T>
+DTypeId DataTypeIdOf(SimStruct *S)
+{
+#if SFU_HAVE_HALF_DTYPE
+    if constexpr (std::is_same_v<T, real16_T>)
+        return ssRegisterDataTypeHalfPrecision(S, 0);
+    else
+#endif
+    {
+        (void)S;
+        return SimulinkDataTypeId<T>();
+    }
+}
+
+namespace data_type_detail
+{
+    template <typename Visitor, typename... Types>
+    bool VisitBuiltIn(DTypeId id, Visitor &visitor, std::tuple<Types...> *)
+    {
+        return ((id == DataTypeTraits<Types>::id ? (visitor(DataTypeTag<Types>{}), true) : false) || ...);
+    }
+}
+
+/**
+ * Call visitor(DataTypeTag<T>{}) with the C++ type T of data type id, e.g.
+ *
+ *   VisitDataType(S, ssGetInputPortDataType(S, 0), [&](auto tag) {
+ *       using T = typename decltype(tag)::type;
+ *       ...
+ *   });
+ *
+ * Returns false and sets the error status if id has no C++ type here;
+ * there is no fallback to double.
+ */
+template <typename Visitor>
+bool VisitDataType(SimStruct *S, DTypeId id, Visitor &&visitor)
+{
+    if (data_type_detail::VisitBuiltIn(id, visitor, static_cast<SimulinkBuiltInTypes *>(nullptr)))
+        return true;
+#if SFU_HAVE_HALF_DTYPE
+    if (id >= 0 && id == ssGetDataTypeId(S, "half"))
+    {
+        visitor(DataTypeTag<real16_T>{});
+        return true;
+    }
+#endif
+    SetErrorStatusf(S, "Data type %d is not supported", (int)id);
+    return false;
+}
+
+template <typename Signature>
+class DataTypeDispatch;
+
+/**
+ * Function pointer to the instantiation of a kernel for one data type,
+ * selected once (e.g. in mdlStart) so the per-step call does not branch
+ * on the type. The kernel is a class with a static member template Run:
+ *
+ *   struct Gain
+ *   {
+ *       template <typename T>
+ *       static void Run(SimStruct *S, real_T gain) { ... GetVectorInputPortView<T>(S, 0, width) ... }
+ *   };
+ *
+ *   DataTypeDispatch<void(SimStruct *, real_T)> gain; // e.g. in a StateArena
+ *   gain.Bind<Gain>(S, ssGetInputPortDataType(S, 0)); // mdlStart
+ *   gain(S, 2.0);                                     // mdlOutputs
+ */
+template <typename R, typename... Args>
+class DataTypeDispatch<R(Args...)>
+{
+public:
+    using Function = R (*)(Args...);
+
+    /** Select Kernel::Run<T> for data type id; false (and error status set) if id is not supported. */
+    template <typename Kernel>
+    bool Bind(SimStruct *S, DTypeId id)
+    {
+        function_ = nullptr;
+        dataType_ = id;
+        return VisitDataType(S, id, [this](auto tag)
+                             { function_ = &Kernel::template Run<typename decltype(tag)::type>; });
+    }
+
+    bool bound() const noexcept { return function_ != nullptr; }
+    explicit operator bool() const noexcept { return bound(); }
+    DTypeId dataType() const noexcept { return dataType_; }
+    Function function() const noexcept { return function_; }
+
+    R operator()(Args... args) const { return function_(static_cast<Args>(args)...); }
+
+private:
+    Function function_ = nullptr;
+    DTypeId dataType_ = DYNAMICALLY_TYPED;
+};
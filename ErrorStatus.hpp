@@ -0,0 +1,109 @@
+#pragma once
+
+#include "simstruc.h"
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// Maximum length of an error message, including the terminating NUL
+#ifndef SFU_ERROR_MESSAGE_CAPACITY
+#define SFU_ERROR_MESSAGE_CAPACITY 512
+#endif
+
+// Number of S-Function instances that can hold an error message at the same time
+#ifndef SFU_ERROR_SLOT_COUNT
+#define SFU_ERROR_SLOT_COUNT 64
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SFU_PRINTF_FORMAT(formatIndex, firstArg) __attribute__((format(printf, formatIndex, firstArg)))
+#else
+#define SFU_PRINTF_FORMAT(formatIndex, firstArg)
+#endif
+
+/**
+ * MATLAB requires error messages to be in persistent memory.
+ * Each SimStruct claims its own fixed-size buffer from a static table the
+ * first time it reports an error, so instances failing at the same time
+ * (or parallel simulations in one process) never share a buffer, and
+ * reporting an error never allocates.
+ */
+struct ErrorMessageSlot
+{
+    std::atomic<const SimStruct *> owner{nullptr};
+    char message[SFU_ERROR_MESSAGE_CAPACITY];
+};
+
+inline ErrorMessageSlot errorMessageSlots[SFU_ERROR_SLOT_COUNT];
+
+/**
+ * Persistent message buffer (SFU_ERROR_MESSAGE_CAPACITY bytes) owned by S.
+ * If all slots are owned by other instances, a per-thread buffer is used.
+ */
+inline char *GetErrorMessageBuffer(const SimStruct *S)
+{
+    const size_t start = (size_t)((((uintptr_t)S >> 4) * 0x9E3779B97F4A7C15ull) % SFU_ERROR_SLOT_COUNT);
+    // Look for the slot S already owns first, so a slot released earlier in
+    // the probe chain is not claimed a second time
+    for (size_t probe = 0; probe < SFU_ERROR_SLOT_COUNT; ++probe)
+    {
+        ErrorMessageSlot &slot = errorMessageSlots[(start + probe) % SFU_ERROR_SLOT_COUNT];
+        if (slot.owner.load(std::memory_order_acquire) == S)
+            return slot.message;
+    }
+    for (size_t probe = 0; probe < SFU_ERROR_SLOT_COUNT; ++probe)
+    {
+        ErrorMessageSlot &slot = errorMessageSlots[(start + probe) % SFU_ERROR_SLOT_COUNT];
+        const SimStruct *owner = nullptr;
+        if (slot.owner.compare_exchange_strong(owner, S, std::memory_order_acq_rel))
+            return slot.message;
+    }
+
+    static thread_local char overflowMessage[SFU_ERROR_MESSAGE_CAPACITY];
+    return overflowMessage;
+}
+
+/**
+ * Give the message buffer of S back to the table, e.g. at the end of mdlTerminate.
+ * The last message stays readable until another instance claims the slot.
+ */
+inline void ReleaseErrorMessageBuffer(const SimStruct *S)
+{
+    for (ErrorMessageSlot &slot : errorMessageSlots)
+    {
+        const SimStruct *owner = S;
+        slot.owner.compare_exchange_strong(owner, nullptr, std::memory_order_acq_rel);
+    }
+}
+
+/**
+ * printf-style ssSetErrorStatus(). The message is formatted into the
+ * buffer owned by S and truncated to SFU_ERROR_MESSAGE_CAPACITY - 1 characters.
+ */
+inline void SetErrorStatusf(SimStruct *S, const char *format, ...) SFU_PRINTF_FORMAT(2, 3);
+inline void SetErrorStatusf(SimStruct *S, const char *format, ...)
+{
+    char *message = GetErrorMessageBuffer(S);
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(message, SFU_ERROR_MESSAGE_CAPACITY, format, args);
+    va_end(args);
+    ssSetErrorStatus(S, message);
+}
+
+/**
+ * printf-style ssWarning(). Warnings are displayed right away,
+ * so the message is formatted on the stack.
+ */
+inline void Warningf(SimStruct *S, const char *format, ...) SFU_PRINTF_FORMAT(2, 3);
+inline void Warningf(SimStruct *S, const char *format, ...)
+{
+    char message[SFU_ERROR_MESSAGE_CAPACITY];
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+    ssWarning(S, message);
+}
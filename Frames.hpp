@@ -0,0 +1,196 @@
+#pragma once
+
+#include "IO.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/**
+ * Define a frame-based input port carrying frameSize samples of each of
+ * channels channels per step: a frameSize x channels matrix, one column
+ * per channel (column-major, so each channel's samples are contiguous).
+ */
+template <typename T>
+void DefineFrameInputPort(SimStruct *S, int portIndex, int frameSize, int channels = 1, int isDirectFeedthrough = 0)
+{
+    DefineInputPort<T>(S, portIndex, frameSize, channels, isDirectFeedthrough);
+    if (ssGetNumInputPorts(S) <= portIndex)
+        return;
+
+    // Frames are always 2-D, also with a single channel
+    ssSetInputPortMatrixDimensions(S, portIndex, frameSize, channels);
+    ssSetInputPortFrameData(S, portIndex, FRAME_YES);
+}
+
+/** Define a frame-based output port of frameSize x channels samples, see DefineFrameInputPort(). */
+template <typename T>
+void DefineFrameOutputPort(SimStruct *S, int portIndex, int frameSize, int channels = 1)
+{
+    DefineOutputPort<T>(S, portIndex, frameSize, channels);
+    if (ssGetNumOutputPorts(S) <= portIndex)
+        return;
+
+    ssSetOutputPortMatrixDimensions(S, portIndex, frameSize, channels);
+    ssSetOutputPortFrameData(S, portIndex, FRAME_YES);
+}
+
+/**
+ * View over the current frame of a frame-based input port:
+ * rows() samples per channel, cols() channels, view.column(c) is channel c.
+ */
+template <typename T>
+std::optional<InputMatrixView<T>> GetFrameInputPortView(SimStruct *S, int portIndex, size_t frameSize, size_t channels = 1)
+{
+    if (ssGetNumInputPorts(S) > portIndex && ssGetInputPortFrameData(S, portIndex) != FRAME_YES)
+    {
+        SetErrorStatusf(S, "Input port %d is not frame-based, check DefineFrameInputPort()", portIndex);
+        return std::nullopt;
+    }
+    return Get2DMatrixInputPortView<T>(S, portIndex, frameSize, channels);
+}
+
+/** View over the frame of a frame-based output port, written in place. */
+template <typename T>
+std::optional<OutputMatrixView<T>> GetFrameOutputPortView(SimStruct *S, int portIndex, size_t frameSize, size_t channels = 1)
+{
+    if (ssGetNumOutputPorts(S) > portIndex && ssGetOutputPortFrameData(S, portIndex) != FRAME_YES)
+    {
+        SetErrorStatusf(S, "Output port %d is not frame-based, check DefineFrameOutputPort()", portIndex);
+        return std::nullopt;
+    }
+    T *outputSignal = GetOutputPortSignal<T>(S, portIndex, frameSize * channels);
+    if (!outputSignal)
+        return std::nullopt;
+
+    return OutputMatrixView<T>(outputSignal, frameSize, channels);
+}
+
+/**
+ * Collects a stream of samples, arriving in chunks of any size (one sample
+ * per step from a sample-based port, or whole frames), into frames of
+ * frameSize samples that overlap by `overlap` samples. Consecutive frames
+ * start hopSize() = frameSize - overlap samples apart.
+ *
+ *   FrameRingBuffer<real_T> buffer(1024, 512); // in mdlStart
+ *
+ *   // mdlOutputs: call kernel once per completed frame
+ *   buffer.Push(input, width, [&](InputPortView<real_T> frame) { Spectrum(frame); });
+ *
+ * Every frame handed out is contiguous: the ring is stored twice back to
+ * back, so a frame never wraps around and is never copied. Storage is
+ * allocated once by the constructor or Configure(); Write() and Push()
+ * do not allocate.
+ */
+template <typename T>
+class FrameRingBuffer
+{
+public:
+    FrameRingBuffer() = default;
+    FrameRingBuffer(size_t frameSize, size_t overlap = 0) { Configure(frameSize, overlap); }
+
+    /**
+     * Set frame size and overlap and drop all pending samples.
+     * Returns false if frameSize is 0 or overlap is not smaller than frameSize.
+     */
+    bool Configure(size_t frameSize, size_t overlap = 0)
+    {
+        if (frameSize == 0 || overlap >= frameSize)
+            return false;
+        frameSize_ = frameSize;
+        hopSize_ = frameSize - overlap;
+        storage_.assign(2 * frameSize, T());
+        start_ = 0;
+        count_ = 0;
+        return true;
+    }
+
+    /** Drop all pending samples, e.g. in mdlInitializeConditions. */
+    void Reset()
+    {
+        std::fill(storage_.begin(), storage_.end(), T());
+        start_ = 0;
+        count_ = 0;
+    }
+
+    size_t frameSize() const noexcept { return frameSize_; }
+    size_t hopSize() const noexcept { return hopSize_; }
+    size_t overlap() const noexcept { return frameSize_ - hopSize_; }
+    // Samples collected for the next frame
+    size_t pending() const noexcept { return count_; }
+
+    /**
+     * Append up to count samples and return how many were taken. Stops
+     * when a frame is complete; call Advance() before writing more.
+     */
+    size_t Write(const T *samples, size_t count)
+    {
+        const size_t accepted = std::min(count, frameSize_ - count_);
+        size_t position = start_ + count_;
+        if (position >= frameSize_)
+            position -= frameSize_;
+
+        const size_t first = std::min(accepted, frameSize_ - position);
+        WriteMirrored(position, samples, first);
+        WriteMirrored(0, samples + first, accepted - first);
+        count_ += accepted;
+        return accepted;
+    }
+
+    bool FrameReady() const noexcept { return frameSize_ != 0 && count_ == frameSize_; }
+
+    /** The completed frame; only valid while FrameReady(). */
+    InputPortView<T> Frame() const noexcept { return InputPortView<T>(storage_.data() + start_, frameSize_); }
+
+    /** Release the first hopSize() samples of the completed frame; the overlap stays pending. */
+    void Advance() noexcept
+    {
+        start_ += hopSize_;
+        if (start_ >= frameSize_)
+            start_ -= frameSize_;
+        count_ -= hopSize_;
+    }
+
+    /**
+     * Append count samples and call kernel(InputPortView<T>) for every frame
+     * completed by them. Returns the number of frames processed.
+     */
+    template <typename Kernel>
+    size_t Push(const T *samples, size_t count, Kernel &&kernel)
+    {
+        size_t frames = 0;
+        while (count > 0 || FrameReady())
+        {
+            const size_t written = Write(samples, count);
+            samples += written;
+            count -= written;
+            if (!FrameReady())
+                break;
+            kernel(Frame());
+            Advance();
+            ++frames;
+        }
+        return frames;
+    }
+
+    template <typename Kernel>
+    size_t Push(InputPortView<T> samples, Kernel &&kernel)
+    {
+        return Push(samples.data(), samples.size(), std::forward<Kernel>(kernel));
+    }
+
+private:
+    // Sample i of the ring is kept at i and i + frameSize
+    void WriteMirrored(size_t position, const T *samples, size_t count)
+    {
+        std::copy(samples, samples + count, storage_.data() + position);
+        std::copy(samples, samples + count, storage_.data() + position + frameSize_);
+    }
+
+    std::vector<T> storage_;
+    size_t frameSize_ = 0;
+    size_t hopSize_ = 0;
+    size_t start_ = 0;
+    size_t count_ = 0;
+};
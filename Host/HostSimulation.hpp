@@ -0,0 +1,291 @@
+#pragma once
+
+#include "simstruc.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * Callbacks of one S-Function, collected by the host simulink.c that the
+ * S-Function source includes at its end. Optional callbacks are null when
+ * the corresponding MDL_* macro is not defined.
+ */
+struct HostSFunction
+{
+    void (*initializeSizes)(SimStruct *S) = nullptr;
+    void (*initializeSampleTimes)(SimStruct *S) = nullptr;
+    void (*setWorkWidths)(SimStruct *S) = nullptr;
+    void (*start)(SimStruct *S) = nullptr;
+    void (*initializeConditions)(SimStruct *S) = nullptr;
+    void (*processParameters)(SimStruct *S) = nullptr;
+    void (*outputs)(SimStruct *S, int_T tid) = nullptr;
+    void (*update)(SimStruct *S, int_T tid) = nullptr;
+    void (*derivatives)(SimStruct *S) = nullptr;
+    void (*terminate)(SimStruct *S) = nullptr;
+};
+
+/**
+ * Name of the registration function generated for S_FUNCTION_NAME, e.g.
+ *
+ *   SFU_DECLARE_HOST_SFUNCTION(my_sfunction);
+ *   HostSimulation sim(SFU_HOST_SFUNCTION(my_sfunction)());
+ */
+#define SFU_HOST_SFUNCTION_CONCAT(a, b) a##b
+#define SFU_HOST_SFUNCTION(name) SFU_HOST_SFUNCTION_CONCAT(HostSFunction_, name)
+#define SFU_DECLARE_HOST_SFUNCTION(name) HostSFunction SFU_HOST_SFUNCTION(name)()
+
+/** Bytes per element; complex ports hold real and imaginary part interleaved. */
+inline size_t HostElementSize(const HostPort &port)
+{
+    return (size_t)ssGetDataTypeSize(nullptr, port.dataType) * (port.complexSignal == COMPLEX_YES ? 2 : 1);
+}
+
+inline size_t HostPortBytes(const HostPort &port)
+{
+    return (size_t)port.width * HostElementSize(port);
+}
+
+inline void HostAllocatePort(HostPort &port)
+{
+    port.storage.assign((HostPortBytes(port) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t) + 1, 0);
+    port.signal = port.storage.data();
+}
+
+/**
+ * Allocate the signal buffers of all ports of S from their current width and
+ * data type. HostSimulation does this after mdlInitializeSizes; call it
+ * directly to exercise port accessors on a hand-built SimStruct.
+ */
+inline void HostAllocatePorts(SimStruct *S)
+{
+    for (HostPort &port : S->inputs)
+    {
+        HostAllocatePort(port);
+        const size_t elementSize = HostElementSize(port);
+        port.signalPtrs.resize(port.width);
+        for (int_T i = 0; i < port.width; ++i)
+            port.signalPtrs[i] = static_cast<const unsigned char *>(port.signal) + i * elementSize;
+    }
+    for (HostPort &port : S->outputs)
+        HostAllocatePort(port);
+}
+
+/**
+ * Minimal fixed-step simulation loop around a single S-Function.
+ *
+ *   HostSimulation sim(SFU_HOST_SFUNCTION(my_sfunction)());
+ *   sim.SetParameter(0, mxCreateDoubleScalar(2.0));
+ *   if (!sim.Initialize())
+ *       fprintf(stderr, "%s\n", sim.Error());
+ *   for (int k = 0; k < 1000; ++k)
+ *   {
+ *       sim.Input<real_T>(0)[0] = k;
+ *       sim.Step();
+ *       use(sim.Output<real_T>(0)[0]);
+ *   }
+ *   sim.Terminate();
+ *
+ * Continuous states are integrated with forward Euler. The step size is the
+ * first sample time if it is discrete, otherwise SetStepSize() (default 1 ms).
+ */
+class HostSimulation
+{
+public:
+    explicit HostSimulation(const HostSFunction &sfunction) : sfunction_(sfunction) {}
+
+    ~HostSimulation()
+    {
+        Terminate();
+        for (mxArray *param : parameters_)
+            mxDestroyArray(param);
+    }
+
+    HostSimulation(const HostSimulation &) = delete;
+    HostSimulation &operator=(const HostSimulation &) = delete;
+
+    /** Set dialog parameter index; takes ownership of value. */
+    void SetParameter(int index, mxArray *value)
+    {
+        if (index >= (int)parameters_.size())
+            parameters_.resize(index + 1, nullptr);
+        mxDestroyArray(parameters_[index]);
+        parameters_[index] = value;
+        S_.sfcnParams.assign(parameters_.begin(), parameters_.end());
+    }
+
+    /**
+     * Change a parameter while running; calls mdlProcessParameters.
+     * Takes ownership of value.
+     */
+    bool UpdateParameter(int index, mxArray *value)
+    {
+        SetParameter(index, value);
+        if (started_ && sfunction_.processParameters)
+            sfunction_.processParameters(&S_);
+        return !HasError();
+    }
+
+    /**
+     * Data type an input port defined as DYNAMICALLY_TYPED receives, as if
+     * driven by a signal of that type. Call before Initialize().
+     * Dynamically typed outputs take the type of the first such input.
+     */
+    void SetInputDataType(int port, DTypeId dataType)
+    {
+        if (port >= (int)inputTypes_.size())
+            inputTypes_.resize(port + 1, DYNAMICALLY_TYPED);
+        inputTypes_[port] = dataType;
+    }
+
+    void SetStepSize(time_T stepSize) { stepSize_ = stepSize; }
+    time_T StepSize() const { return stepSize_; }
+
+    /**
+     * mdlInitializeSizes, port buffer allocation, mdlInitializeSampleTimes,
+     * mdlSetWorkWidths, mdlStart and mdlInitializeConditions, in Simulink's order.
+     */
+    bool Initialize()
+    {
+        if (!sfunction_.initializeSizes || !sfunction_.outputs)
+            return Fail("S-Function does not provide mdlInitializeSizes and mdlOutputs");
+
+        sfunction_.initializeSizes(&S_);
+        if (HasError())
+            return false;
+        if (ssGetNumSFcnParams(&S_) != ssGetSFcnParamsCount(&S_))
+            return Fail("Number of parameters set does not match ssSetNumSFcnParams()");
+
+        if (!ResolveDataTypes())
+            return false;
+        HostAllocatePorts(&S_);
+
+        if (sfunction_.initializeSampleTimes)
+            sfunction_.initializeSampleTimes(&S_);
+        if (!S_.sampleTimes.empty() && S_.sampleTimes[0] > 0.0)
+            stepSize_ = S_.sampleTimes[0];
+
+        const Callback setup[] = {sfunction_.setWorkWidths, sfunction_.start, sfunction_.initializeConditions};
+        for (Callback callback : setup)
+        {
+            if (callback)
+                callback(&S_);
+            if (HasError())
+                return false;
+        }
+        started_ = true;
+        return true;
+    }
+
+    /** One major time step: mdlOutputs, mdlUpdate, mdlDerivatives + integration. */
+    bool Step()
+    {
+        if (!started_)
+            return Fail("HostSimulation::Step() called before Initialize()");
+
+        sfunction_.outputs(&S_, 0);
+        if (sfunction_.update && !HasError())
+            sfunction_.update(&S_, 0);
+        if (sfunction_.derivatives && !HasError())
+        {
+            sfunction_.derivatives(&S_);
+            for (size_t i = 0; i < S_.contStates.size(); ++i)
+                S_.contStates[i] += stepSize_ * S_.derivatives[i];
+        }
+        S_.t += stepSize_;
+        ++steps_;
+        return !HasError();
+    }
+
+    bool Run(size_t steps)
+    {
+        for (size_t i = 0; i < steps; ++i)
+        {
+            if (!Step())
+                return false;
+        }
+        return true;
+    }
+
+    /** mdlTerminate; called by the destructor if needed. */
+    void Terminate()
+    {
+        if (!started_)
+            return;
+        started_ = false;
+        if (sfunction_.terminate)
+            sfunction_.terminate(&S_);
+    }
+
+    template <typename T>
+    T *Input(int port) { return static_cast<T *>(S_.inputs[port].signal); }
+
+    template <typename T>
+    const T *Output(int port) const { return static_cast<const T *>(S_.outputs[port].signal); }
+
+    /**
+     * Current dimensions of variable-size input port for the following steps.
+     * Fails if they exceed the maximum dimensions the port was defined with.
+     */
+    bool SetInputDimensions(int port, int_T rows, int_T cols = 1)
+    {
+        HostPort &input = S_.inputs[port];
+        if (input.dimsMode != VARIABLE_DIMS_MODE)
+            return Fail("HostSimulation::SetInputDimensions() on an input port without VARIABLE_DIMS_MODE");
+        if (rows < 0 || rows > input.dims[0] || cols < 0 || cols > (input.dims.size() > 1 ? input.dims[1] : 1))
+            return Fail("HostSimulation::SetInputDimensions() exceeds the maximum dimensions of the port");
+        input.currentDims[0] = rows;
+        if (input.dims.size() > 1)
+            input.currentDims[1] = cols;
+        return true;
+    }
+
+    size_t InputBytes(int port) const { return HostPortBytes(S_.inputs[port]); }
+    size_t OutputBytes(int port) const { return HostPortBytes(S_.outputs[port]); }
+
+    SimStruct *GetSimStruct() { return &S_; }
+    size_t StepCount() const { return steps_; }
+    time_T Time() const { return S_.t; }
+
+    bool HasError() const { return S_.errorStatus != nullptr; }
+    const char *Error() const { return S_.errorStatus ? S_.errorStatus : ""; }
+
+private:
+    typedef void (*Callback)(SimStruct *);
+
+    bool Fail(const char *message)
+    {
+        ssSetErrorStatus(&S_, message);
+        return false;
+    }
+
+    bool ResolveDataTypes()
+    {
+        DTypeId inherited = DYNAMICALLY_TYPED;
+        for (size_t port = 0; port < S_.inputs.size(); ++port)
+        {
+            if (S_.inputs[port].dataType != DYNAMICALLY_TYPED)
+                continue;
+            if (port >= inputTypes_.size() || inputTypes_[port] == DYNAMICALLY_TYPED)
+                return Fail("Dynamically typed input port without a data type, use HostSimulation::SetInputDataType()");
+            S_.inputs[port].dataType = inputTypes_[port];
+            if (inherited == DYNAMICALLY_TYPED)
+                inherited = inputTypes_[port];
+        }
+        for (HostPort &output : S_.outputs)
+        {
+            if (output.dataType != DYNAMICALLY_TYPED)
+                continue;
+            if (inherited == DYNAMICALLY_TYPED)
+                return Fail("Dynamically typed output port without a dynamically typed input port");
+            output.dataType = inherited;
+        }
+        return true;
+    }
+
+    HostSFunction sfunction_;
+    SimStruct S_;
+    std::vector<mxArray *> parameters_;
+    std::vector<DTypeId> inputTypes_;
+    time_T stepSize_ = 1e-3;
+    size_t steps_ = 0;
+    bool started_ = false;
+};
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "HostSimulation.hpp"
+#include "SignalLog.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/** First output element that differs from the recording. */
+struct ReplayMismatch
+{
+    size_t record = SIZE_MAX;
+    int port = -1;
+    size_t element = 0;
+};
+
+/**
+ * Feeds a signal log (see SignalLogger) back into an S-Function running in
+ * HostSimulation, one record per step:
+ *
+ *   HostSimulation sim(SFU_HOST_SFUNCTION(my_sfunction)());
+ *   SignalReplay replay;
+ *   if (!replay.Open("run.sfulog") || !sim.Initialize() || !replay.Attach(sim) || !replay.Run(sim))
+ *       fprintf(stderr, "%s\n", replay.error());
+ *   else if (replay.mismatches())
+ *       fprintf(stderr, "output %d differs at record %zu\n", replay.firstMismatch().port, replay.firstMismatch().record);
+ *
+ * Recorded input channels drive the input ports with the same index and
+ * recorded output channels are compared against the output ports with the
+ * same index. Inputs are not copied: during Run() the input port buffers
+ * point into the read-only mapping of the log, so replay runs at the speed
+ * of the block, and a block writing to its inputs faults. The simulation
+ * time of each step is the recorded time stamp. Outputs are compared
+ * bit-exactly (memcmp), so NaN payloads and signed zeros must match too.
+ */
+class SignalReplay
+{
+public:
+    bool Open(const char *path)
+    {
+        inputs_.clear();
+        outputs_.clear();
+        error_ = nullptr;
+        if (!log_.Open(path))
+            return Fail(log_.error());
+        return true;
+    }
+
+    /**
+     * Check the recorded channels against the ports of sim and that the log
+     * has no dropped records. Call after sim.Initialize().
+     */
+    bool Attach(HostSimulation &sim)
+    {
+        inputs_.clear();
+        outputs_.clear();
+        if (!log_.IsOpen())
+            return Fail("No signal log open");
+        // Records after a gap would be compared against the wrong outputs
+        if (log_.dropped() != 0)
+            return Fail("Signal log has dropped records, record the reference with SignalLogOverflow::Wait");
+
+        SimStruct *S = sim.GetSimStruct();
+        for (size_t c = 0; c < log_.channelCount(); ++c)
+        {
+            const SignalLogChannel &channel = log_.Channel(c);
+            const bool isInput = channel.direction == signal_log::Input;
+            const std::vector<HostPort> &ports = isInput ? S->inputs : S->outputs;
+            if (channel.port < 0 || channel.port >= (int)ports.size())
+                return Fail(isInput ? "Recorded input port does not exist" : "Recorded output port does not exist");
+            const HostPort &port = ports[channel.port];
+            if (port.dataType != channel.dataType || (size_t)port.width != channel.width || HostElementSize(port) != channel.elementSize)
+                return Fail(isInput ? "Recorded input channel does not match the data type or width of its port"
+                                    : "Recorded output channel does not match the data type or width of its port");
+            (isInput ? inputs_ : outputs_).push_back(c);
+        }
+        if (inputs_.empty())
+            return Fail("Signal log contains no input channels");
+        return true;
+    }
+
+    /**
+     * Step sim once per record, starting at record first, at most count
+     * records. Compares the outputs after every step if compareOutputs is set.
+     * Returns false if the S-Function reported an error.
+     */
+    bool Run(HostSimulation &sim, bool compareOutputs = true, size_t first = 0, size_t count = SIZE_MAX)
+    {
+        if (inputs_.empty())
+            return Fail("SignalReplay::Run() called before Attach()");
+
+        SimStruct *S = sim.GetSimStruct();
+        const size_t end = first + std::min(count, log_.recordCount() - std::min(first, log_.recordCount()));
+        mismatches_ = 0;
+        firstMismatch_ = ReplayMismatch();
+
+        bool ok = true;
+        for (size_t record = first; record < end; ++record)
+        {
+            for (size_t c : inputs_)
+                PointInput(S->inputs[log_.Channel(c).port], log_.Data(record, c));
+            S->t = log_.Time(record);
+            if (!sim.Step())
+            {
+                ok = Fail(sim.Error());
+                break;
+            }
+            if (compareOutputs)
+                CompareOutputs(S, record);
+        }
+
+        // Give the ports their own buffers back
+        for (size_t c : inputs_)
+        {
+            HostPort &port = S->inputs[log_.Channel(c).port];
+            PointInput(port, port.storage.data());
+        }
+        return ok;
+    }
+
+    const SignalLogReader &log() const noexcept { return log_; }
+    size_t recordCount() const noexcept { return log_.IsOpen() ? log_.recordCount() : 0; }
+
+    /** Records of the last Run() in which any output differed from the recording. */
+    size_t mismatches() const noexcept { return mismatches_; }
+    const ReplayMismatch &firstMismatch() const noexcept { return firstMismatch_; }
+
+    const char *error() const noexcept { return error_ ? error_ : ""; }
+
+private:
+    static void PointInput(HostPort &port, const void *data)
+    {
+        port.signal = const_cast<void *>(data);
+        if (port.requiredContiguous)
+            return;
+        const size_t elementSize = HostElementSize(port);
+        for (int_T i = 0; i < port.width; ++i)
+            port.signalPtrs[i] = static_cast<const unsigned char *>(data) + i * elementSize;
+    }
+
+    void CompareOutputs(SimStruct *S, size_t record)
+    {
+        bool differs = false;
+        for (size_t c : outputs_)
+        {
+            const SignalLogChannel &channel = log_.Channel(c);
+            const unsigned char *recorded = static_cast<const unsigned char *>(log_.Data(record, c));
+            const unsigned char *actual = static_cast<const unsigned char *>(S->outputs[channel.port].signal);
+            const size_t bytes = size_t(channel.width) * channel.elementSize;
+            if (std::memcmp(recorded, actual, bytes) == 0)
+                continue;
+            if (!differs && mismatches_ == 0)
+            {
+                size_t element = 0;
+                while (std::memcmp(recorded + element * channel.elementSize, actual + element * channel.elementSize, channel.elementSize) == 0)
+                    ++element;
+                firstMismatch_ = ReplayMismatch{record, channel.port, element};
+            }
+            differs = true;
+        }
+        mismatches_ += differs;
+    }
+
+    bool Fail(const char *message)
+    {
+        error_ = message;
+        return false;
+    }
+
+    SignalLogReader log_;
+    std::vector<size_t> inputs_;  // channel indices
+    std::vector<size_t> outputs_; // channel indices
+    size_t mismatches_ = 0;
+    ReplayMismatch firstMismatch_;
+    const char *error_ = nullptr;
+};
@@ -0,0 +1,689 @@
+#pragma once
+
+/**
+ * Host-side stand-in for MATLAB's simstruc.h.
+ *
+ * Provides the subset of the SimStruct / mxArray API used by the headers in
+ * this repository, so S-Functions can be compiled, profiled and run under
+ * sanitizers on a machine without MATLAB. Put this directory on the include
+ * path instead of the MATLAB include directories and drive the S-Function
+ * with HostSimulation (HostSimulation.hpp), see README.md.
+ *
+ * Everything here is deliberately simple: the SimStruct is a plain struct
+ * with std::vector members, ss* macros are inline functions, and errors are
+ * recorded instead of stopping a simulation.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdarg>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define SIMSTRUC_HOST_STANDIN 1
+
+/* ---------------------------------------------------------------- types -- */
+
+typedef double real_T;
+typedef float real32_T;
+typedef double real64_T;
+typedef std::int8_t int8_T;
+typedef std::uint8_t uint8_T;
+typedef std::int16_t int16_T;
+typedef std::uint16_t uint16_T;
+typedef std::int32_t int32_T;
+typedef std::uint32_t uint32_T;
+typedef std::int64_t int64_T;
+typedef std::uint64_t uint64_T;
+typedef unsigned char boolean_T;
+typedef char char_T;
+typedef int int_T;
+typedef unsigned int uint_T;
+typedef double time_T;
+typedef std::size_t mwSize;
+typedef std::size_t mwIndex;
+typedef char16_t mxChar;
+typedef int DTypeId;
+
+enum
+{
+    SS_DOUBLE = 0,
+    SS_SINGLE = 1,
+    SS_INT8 = 2,
+    SS_UINT8 = 3,
+    SS_INT16 = 4,
+    SS_UINT16 = 5,
+    SS_INT32 = 6,
+    SS_UINT32 = 7,
+    SS_BOOLEAN = 8,
+    SS_INT64 = 9,
+    SS_UINT64 = 10
+};
+
+#define INVALID_DTYPE_ID (-10)
+
+/** Half precision value, stored as its IEEE 754 binary16 bit pattern */
+struct real16_T
+{
+    std::uint16_t bitPattern;
+};
+
+#define UNUSED_ARG(arg) (void)(arg)
+
+#define DYNAMICALLY_SIZED (-1)
+#define DYNAMICALLY_TYPED (-1)
+#define INHERITED_SAMPLE_TIME (-1.0)
+#define CONTINUOUS_SAMPLE_TIME (0.0)
+#define FIXED_IN_MINOR_STEP_OFFSET (1.0)
+
+typedef enum
+{
+    mxUNKNOWN_CLASS = 0,
+    mxCELL_CLASS,
+    mxSTRUCT_CLASS,
+    mxLOGICAL_CLASS,
+    mxCHAR_CLASS,
+    mxVOID_CLASS,
+    mxDOUBLE_CLASS,
+    mxSINGLE_CLASS,
+    mxINT8_CLASS,
+    mxUINT8_CLASS,
+    mxINT16_CLASS,
+    mxUINT16_CLASS,
+    mxINT32_CLASS,
+    mxUINT32_CLASS,
+    mxINT64_CLASS,
+    mxUINT64_CLASS,
+    mxFUNCTION_CLASS
+} mxClassID;
+
+typedef enum
+{
+    FRAME_INHERITED = -1,
+    FRAME_NO = 0,
+    FRAME_YES = 1
+} Frame_T;
+
+typedef enum
+{
+    SL_NON_BUS_MODE = 0,
+    SL_BUS_MODE = 1
+} BusMode;
+
+typedef enum
+{
+    SS_SIMMODE_NORMAL = 0,
+    SS_SIMMODE_SIZES_CALL_ONLY = 1,
+    SS_SIMMODE_RTWGEN = 2,
+    SS_SIMMODE_EXTERNAL = 3
+} SS_SimMode;
+
+typedef enum
+{
+    INHERIT_DIMS_MODE = -1,
+    FIXED_DIMS_MODE = 0,
+    VARIABLE_DIMS_MODE = 1
+} DimsMode_T;
+
+typedef enum
+{
+    COMPLEX_INHERITED = -1,
+    COMPLEX_NO = 0,
+    COMPLEX_YES = 1
+} CSignal_T;
+
+typedef enum
+{
+    mxREAL = 0,
+    mxCOMPLEX = 1
+} mxComplexity;
+
+// Complex mxArrays store real and imaginary parts interleaved, as with mex -R2018a
+#define MX_HAS_INTERLEAVED_COMPLEX 1
+
+typedef struct { double real, imag; } mxComplexDouble;
+typedef struct { float real, imag; } mxComplexSingle;
+typedef struct { std::int8_t real, imag; } mxComplexInt8;
+typedef struct { std::uint8_t real, imag; } mxComplexUint8;
+typedef struct { std::int16_t real, imag; } mxComplexInt16;
+typedef struct { std::uint16_t real, imag; } mxComplexUint16;
+typedef struct { std::int32_t real, imag; } mxComplexInt32;
+typedef struct { std::uint32_t real, imag; } mxComplexUint32;
+typedef struct { std::int64_t real, imag; } mxComplexInt64;
+typedef struct { std::uint64_t real, imag; } mxComplexUint64;
+
+typedef const void *const *InputPtrsType;
+typedef const real_T *const *InputRealPtrsType;
+
+/* -------------------------------------------------------------- mxArray -- */
+
+struct mxArray
+{
+    mxClassID classID = mxDOUBLE_CLASS;
+    bool isComplex = false;
+    std::vector<mwSize> dims{0, 0};
+    std::vector<unsigned char> data;
+    std::vector<mxArray *> cells;
+};
+
+inline std::size_t mxHostElementSize(mxClassID classID)
+{
+    switch (classID)
+    {
+    case mxDOUBLE_CLASS:
+    case mxINT64_CLASS:
+    case mxUINT64_CLASS:
+        return 8;
+    case mxSINGLE_CLASS:
+    case mxINT32_CLASS:
+    case mxUINT32_CLASS:
+        return 4;
+    case mxINT16_CLASS:
+    case mxUINT16_CLASS:
+    case mxCHAR_CLASS:
+        return 2;
+    case mxINT8_CLASS:
+    case mxUINT8_CLASS:
+    case mxLOGICAL_CLASS:
+        return 1;
+    case mxCELL_CLASS:
+        return sizeof(mxArray *);
+    default:
+        return 0;
+    }
+}
+
+inline mwSize mxGetNumberOfElements(const mxArray *pa)
+{
+    mwSize n = 1;
+    for (mwSize d : pa->dims)
+        n *= d;
+    return n;
+}
+
+inline mxArray *mxCreateNumericMatrix(mwSize m, mwSize n, mxClassID classID, mxComplexity complexity = mxREAL)
+{
+    mxArray *pa = new mxArray;
+    pa->classID = classID;
+    pa->isComplex = complexity == mxCOMPLEX;
+    pa->dims = {m, n};
+    pa->data.assign(m * n * mxHostElementSize(classID) * (pa->isComplex ? 2 : 1), 0);
+    return pa;
+}
+
+inline mxArray *mxCreateDoubleMatrix(mwSize m, mwSize n, mxComplexity complexity = mxREAL)
+{
+    return mxCreateNumericMatrix(m, n, mxDOUBLE_CLASS, complexity);
+}
+
+inline mxArray *mxCreateDoubleScalar(double value)
+{
+    mxArray *pa = mxCreateDoubleMatrix(1, 1);
+    std::memcpy(pa->data.data(), &value, sizeof(value));
+    return pa;
+}
+
+inline mxArray *mxCreateString(const char *str)
+{
+    const std::size_t len = std::strlen(str);
+    mxArray *pa = mxCreateNumericMatrix(len ? 1 : 0, len, mxCHAR_CLASS);
+    mxChar *chars = reinterpret_cast<mxChar *>(pa->data.data());
+    for (std::size_t i = 0; i < len; ++i)
+        chars[i] = static_cast<unsigned char>(str[i]);
+    return pa;
+}
+
+inline mxArray *mxCreateCellMatrix(mwSize m, mwSize n)
+{
+    mxArray *pa = new mxArray;
+    pa->classID = mxCELL_CLASS;
+    pa->dims = {m, n};
+    pa->cells.assign(m * n, nullptr);
+    return pa;
+}
+
+inline void mxDestroyArray(mxArray *pa)
+{
+    if (!pa)
+        return;
+    for (mxArray *cell : pa->cells)
+        mxDestroyArray(cell);
+    delete pa;
+}
+
+inline void mxSetCell(mxArray *pa, mwIndex i, mxArray *value)
+{
+    mxDestroyArray(pa->cells[i]);
+    pa->cells[i] = value;
+}
+
+inline mxArray *mxGetCell(const mxArray *pa, mwIndex i)
+{
+    return i < pa->cells.size() ? pa->cells[i] : nullptr;
+}
+
+inline mxClassID mxGetClassID(const mxArray *pa) { return pa->classID; }
+inline bool mxIsChar(const mxArray *pa) { return pa->classID == mxCHAR_CLASS; }
+inline bool mxIsCell(const mxArray *pa) { return pa->classID == mxCELL_CLASS; }
+inline bool mxIsDouble(const mxArray *pa) { return pa->classID == mxDOUBLE_CLASS; }
+inline bool mxIsLogical(const mxArray *pa) { return pa->classID == mxLOGICAL_CLASS; }
+inline bool mxIsComplex(const mxArray *pa) { return pa->isComplex; }
+inline bool mxIsEmpty(const mxArray *pa) { return mxGetNumberOfElements(pa) == 0; }
+inline bool mxIsNumeric(const mxArray *pa) { return pa->classID >= mxDOUBLE_CLASS && pa->classID <= mxUINT64_CLASS; }
+inline mwSize mxGetNumberOfDimensions(const mxArray *pa) { return pa->dims.size(); }
+inline const mwSize *mxGetDimensions(const mxArray *pa) { return pa->dims.data(); }
+inline mwSize mxGetM(const mxArray *pa) { return pa->dims[0]; }
+inline mwSize mxGetN(const mxArray *pa) { return mxGetNumberOfElements(pa) / (pa->dims[0] ? pa->dims[0] : 1); }
+// With interleaved complex, the element of a complex array is the real/imaginary pair
+inline std::size_t mxGetElementSize(const mxArray *pa) { return mxHostElementSize(pa->classID) * (pa->isComplex ? 2 : 1); }
+inline void *mxGetData(const mxArray *pa) { return const_cast<unsigned char *>(pa->data.data()); }
+inline double *mxGetPr(const mxArray *pa) { return static_cast<double *>(mxGetData(pa)); }
+inline mxChar *mxGetChars(const mxArray *pa) { return pa->classID == mxCHAR_CLASS ? static_cast<mxChar *>(mxGetData(pa)) : nullptr; }
+
+/* interleaved complex data, nullptr for real arrays or another class */
+#define SFU_HOST_COMPLEX_ACCESSOR(name, type, mxClass) \
+    inline type *name(const mxArray *pa) { return pa->isComplex && pa->classID == mxClass ? static_cast<type *>(mxGetData(pa)) : nullptr; }
+SFU_HOST_COMPLEX_ACCESSOR(mxGetComplexDoubles, mxComplexDouble, mxDOUBLE_CLASS)
+SFU_HOST_COMPLEX_ACCESSOR(mxGetComplexSingles, mxComplexSingle, mxSINGLE_CLASS)
+SFU_HOST_COMPLEX_ACCESSOR(mxGetComplexInt8s, mxComplexInt8, mxINT8_CLASS)
+SFU_HOST_COMPLEX_ACCESSOR(mxGetComplexUint8s, mxComplexUint8, mxUINT8_CLASS)
+SFU_HOST_COMPLEX_ACCESSOR(mxGetComplexInt16s, mxComplexInt16, mxINT16_CLASS)
+SFU_HOST_COMPLEX_ACCESSOR(mxGetComplexUint16s, mxComplexUint16, mxUINT16_CLASS)
+SFU_HOST_COMPLEX_ACCESSOR(mxGetComplexInt32s, mxComplexInt32, mxINT32_CLASS)
+SFU_HOST_COMPLEX_ACCESSOR(mxGetComplexUint32s, mxComplexUint32, mxUINT32_CLASS)
+SFU_HOST_COMPLEX_ACCESSOR(mxGetComplexInt64s, mxComplexInt64, mxINT64_CLASS)
+SFU_HOST_COMPLEX_ACCESSOR(mxGetComplexUint64s, mxComplexUint64, mxUINT64_CLASS)
+#undef SFU_HOST_COMPLEX_ACCESSOR
+
+inline const char *mxGetClassName(const mxArray *pa)
+{
+    static const char *const names[] = {"unknown", "cell", "struct", "logical", "char", "void",
+                                        "double", "single", "int8", "uint8", "int16", "uint16",
+                                        "int32", "uint32", "int64", "uint64", "function_handle"};
+    return names[pa->classID];
+}
+
+inline double mxGetScalar(const mxArray *pa)
+{
+    if (pa->data.empty())
+        return 0.0;
+    const void *p = pa->data.data();
+    switch (pa->classID)
+    {
+    case mxDOUBLE_CLASS: return *static_cast<const double *>(p);
+    case mxSINGLE_CLASS: return *static_cast<const float *>(p);
+    case mxINT8_CLASS: return *static_cast<const std::int8_t *>(p);
+    case mxUINT8_CLASS: return *static_cast<const std::uint8_t *>(p);
+    case mxLOGICAL_CLASS: return *static_cast<const std::uint8_t *>(p);
+    case mxINT16_CLASS: return *static_cast<const std::int16_t *>(p);
+    case mxUINT16_CLASS: return *static_cast<const std::uint16_t *>(p);
+    case mxCHAR_CLASS: return *static_cast<const mxChar *>(p);
+    case mxINT32_CLASS: return *static_cast<const std::int32_t *>(p);
+    case mxUINT32_CLASS: return *static_cast<const std::uint32_t *>(p);
+    case mxINT64_CLASS: return static_cast<double>(*static_cast<const std::int64_t *>(p));
+    case mxUINT64_CLASS: return static_cast<double>(*static_cast<const std::uint64_t *>(p));
+    default: return 0.0;
+    }
+}
+
+inline void *mxCalloc(std::size_t n, std::size_t size) { return std::calloc(n, size); }
+inline void *mxMalloc(std::size_t n) { return std::malloc(n); }
+inline void mxFree(void *ptr) { std::free(ptr); }
+
+inline char *mxArrayToString(const mxArray *pa)
+{
+    if (!mxIsChar(pa))
+        return nullptr;
+    const mwSize n = mxGetNumberOfElements(pa);
+    char *str = static_cast<char *>(mxCalloc(n + 1, 1));
+    const mxChar *chars = reinterpret_cast<const mxChar *>(pa->data.data());
+    for (mwSize i = 0; i < n; ++i)
+        str[i] = static_cast<char>(chars[i]);
+    return str;
+}
+
+/** Copies at most buflen - 1 characters; returns 1 if truncated, like MATLAB. */
+inline int mxGetString(const mxArray *pa, char *buf, mwSize buflen)
+{
+    if (!mxIsChar(pa) || buflen == 0)
+        return 1;
+    const mwSize n = mxGetNumberOfElements(pa);
+    const mwSize copied = n < buflen - 1 ? n : buflen - 1;
+    const mxChar *chars = reinterpret_cast<const mxChar *>(pa->data.data());
+    for (mwSize i = 0; i < copied; ++i)
+        buf[i] = static_cast<char>(chars[i]);
+    buf[copied] = '\0';
+    return copied < n ? 1 : 0;
+}
+
+/* ------------------------------------------------------------ SimStruct -- */
+
+struct HostPort
+{
+    int_T width = 0;
+    std::vector<int_T> dims;
+    DTypeId dataType = SS_DOUBLE;
+    int_T directFeedThrough = 0;
+    int_T requiredContiguous = 0;
+    Frame_T frameData = FRAME_NO;
+    CSignal_T complexSignal = COMPLEX_NO;
+    DimsMode_T dimsMode = FIXED_DIMS_MODE;
+    BusMode busMode = SL_NON_BUS_MODE;
+    int_T busAsStruct = 0;
+    const char *busObjectName = nullptr;
+    // Dimensions of the current step; the buffer always has the maximum (dims)
+    std::vector<int_T> currentDims;
+
+    // Signal buffer, allocated by HostSimulation once the port sizes are known
+    std::vector<std::uint64_t> storage;
+    void *signal = nullptr;
+    // Per-element pointers for ssGetInputPortSignalPtrs()
+    std::vector<const void *> signalPtrs;
+};
+
+struct SimStruct
+{
+    const char *modelName = "host";
+    const char *path = "host/S-Function";
+
+    std::vector<HostPort> inputs;
+    std::vector<HostPort> outputs;
+
+    int_T numSFcnParams = 0;
+    std::vector<const mxArray *> sfcnParams;
+
+    int_T numSampleTimes = 1;
+    std::vector<time_T> sampleTimes{INHERITED_SAMPLE_TIME};
+    std::vector<time_T> offsetTimes{0.0};
+    time_T t = 0.0;
+
+    std::vector<real_T> contStates;
+    std::vector<real_T> derivatives;
+    std::vector<real_T> discStates;
+
+    std::vector<real_T> rwork;
+    std::vector<int_T> iwork;
+    std::vector<void *> pwork;
+    int_T numModes = 0;
+    int_T numNonsampledZCs = 0;
+    uint_T options = 0;
+
+    const char *errorStatus = nullptr;
+    std::string lastWarning;
+    int_T numWarnings = 0;
+};
+
+/* ports */
+inline int_T ssGetNumInputPorts(const SimStruct *S) { return static_cast<int_T>(S->inputs.size()); }
+inline int_T ssGetNumOutputPorts(const SimStruct *S) { return static_cast<int_T>(S->outputs.size()); }
+inline bool ssSetNumInputPorts(SimStruct *S, int_T n)
+{
+    S->inputs.resize(n);
+    return true;
+}
+inline bool ssSetNumOutputPorts(SimStruct *S, int_T n)
+{
+    S->outputs.resize(n);
+    return true;
+}
+
+inline void ssSetInputPortWidth(SimStruct *S, int_T port, int_T width)
+{
+    S->inputs[port].width = width;
+    S->inputs[port].dims = {width};
+    S->inputs[port].currentDims = S->inputs[port].dims;
+}
+inline void ssSetOutputPortWidth(SimStruct *S, int_T port, int_T width)
+{
+    S->outputs[port].width = width;
+    S->outputs[port].dims = {width};
+    S->outputs[port].currentDims = S->outputs[port].dims;
+}
+inline int_T ssGetInputPortWidth(const SimStruct *S, int_T port) { return S->inputs[port].width; }
+inline int_T ssGetOutputPortWidth(const SimStruct *S, int_T port) { return S->outputs[port].width; }
+
+inline bool ssSetInputPortMatrixDimensions(SimStruct *S, int_T port, int_T rows, int_T cols)
+{
+    S->inputs[port].width = rows * cols;
+    S->inputs[port].dims = {rows, cols};
+    S->inputs[port].currentDims = S->inputs[port].dims;
+    return true;
+}
+inline bool ssSetOutputPortMatrixDimensions(SimStruct *S, int_T port, int_T rows, int_T cols)
+{
+    S->outputs[port].width = rows * cols;
+    S->outputs[port].dims = {rows, cols};
+    S->outputs[port].currentDims = S->outputs[port].dims;
+    return true;
+}
+inline int_T ssGetInputPortNumDimensions(const SimStruct *S, int_T port) { return static_cast<int_T>(S->inputs[port].dims.size()); }
+inline int_T ssGetOutputPortNumDimensions(const SimStruct *S, int_T port) { return static_cast<int_T>(S->outputs[port].dims.size()); }
+inline int_T *ssGetInputPortDimensions(SimStruct *S, int_T port) { return S->inputs[port].dims.data(); }
+inline int_T *ssGetOutputPortDimensions(SimStruct *S, int_T port) { return S->outputs[port].dims.data(); }
+
+inline void ssSetInputPortDataType(SimStruct *S, int_T port, DTypeId id) { S->inputs[port].dataType = id; }
+inline void ssSetOutputPortDataType(SimStruct *S, int_T port, DTypeId id) { S->outputs[port].dataType = id; }
+inline DTypeId ssGetInputPortDataType(const SimStruct *S, int_T port) { return S->inputs[port].dataType; }
+inline DTypeId ssGetOutputPortDataType(const SimStruct *S, int_T port) { return S->outputs[port].dataType; }
+
+inline void ssSetInputPortDirectFeedThrough(SimStruct *S, int_T port, int_T dft) { S->inputs[port].directFeedThrough = dft; }
+inline int_T ssGetInputPortDirectFeedThrough(const SimStruct *S, int_T port) { return S->inputs[port].directFeedThrough; }
+inline void ssSetInputPortRequiredContiguous(SimStruct *S, int_T port, int_T contiguous) { S->inputs[port].requiredContiguous = contiguous; }
+inline int_T ssGetInputPortRequiredContiguous(const SimStruct *S, int_T port) { return S->inputs[port].requiredContiguous; }
+
+inline void ssSetInputPortFrameData(SimStruct *S, int_T port, Frame_T frameData) { S->inputs[port].frameData = frameData; }
+inline void ssSetOutputPortFrameData(SimStruct *S, int_T port, Frame_T frameData) { S->outputs[port].frameData = frameData; }
+inline Frame_T ssGetInputPortFrameData(const SimStruct *S, int_T port) { return S->inputs[port].frameData; }
+inline Frame_T ssGetOutputPortFrameData(const SimStruct *S, int_T port) { return S->outputs[port].frameData; }
+
+inline void ssSetInputPortComplexSignal(SimStruct *S, int_T port, CSignal_T complexSignal) { S->inputs[port].complexSignal = complexSignal; }
+inline void ssSetOutputPortComplexSignal(SimStruct *S, int_T port, CSignal_T complexSignal) { S->outputs[port].complexSignal = complexSignal; }
+inline CSignal_T ssGetInputPortComplexSignal(const SimStruct *S, int_T port) { return S->inputs[port].complexSignal; }
+inline CSignal_T ssGetOutputPortComplexSignal(const SimStruct *S, int_T port) { return S->outputs[port].complexSignal; }
+
+inline void ssSetInputPortBusMode(SimStruct *S, int_T port, BusMode mode) { S->inputs[port].busMode = mode; }
+inline void ssSetOutputPortBusMode(SimStruct *S, int_T port, BusMode mode) { S->outputs[port].busMode = mode; }
+inline BusMode ssGetInputPortBusMode(const SimStruct *S, int_T port) { return S->inputs[port].busMode; }
+inline BusMode ssGetOutputPortBusMode(const SimStruct *S, int_T port) { return S->outputs[port].busMode; }
+inline void ssSetBusInputAsStruct(SimStruct *S, int_T port, int_T asStruct) { S->inputs[port].busAsStruct = asStruct; }
+inline void ssSetBusOutputAsStruct(SimStruct *S, int_T port, int_T asStruct) { S->outputs[port].busAsStruct = asStruct; }
+inline int_T ssGetBusInputAsStruct(const SimStruct *S, int_T port) { return S->inputs[port].busAsStruct; }
+inline int_T ssGetBusOutputAsStruct(const SimStruct *S, int_T port) { return S->outputs[port].busAsStruct; }
+inline void ssSetBusOutputObjectName(SimStruct *S, int_T port, void *name) { S->outputs[port].busObjectName = static_cast<const char *>(name); }
+
+inline void ssSetInputPortDimensionsMode(SimStruct *S, int_T port, DimsMode_T mode) { S->inputs[port].dimsMode = mode; }
+inline void ssSetOutputPortDimensionsMode(SimStruct *S, int_T port, DimsMode_T mode) { S->outputs[port].dimsMode = mode; }
+inline DimsMode_T ssGetInputPortDimensionsMode(const SimStruct *S, int_T port) { return S->inputs[port].dimsMode; }
+inline DimsMode_T ssGetOutputPortDimensionsMode(const SimStruct *S, int_T port) { return S->outputs[port].dimsMode; }
+inline int_T ssGetCurrentInputPortDimensions(const SimStruct *S, int_T port, int_T dim) { return S->inputs[port].currentDims[dim]; }
+inline int_T ssGetCurrentOutputPortDimensions(const SimStruct *S, int_T port, int_T dim) { return S->outputs[port].currentDims[dim]; }
+inline void ssSetCurrentOutputPortDimensions(SimStruct *S, int_T port, int_T dim, int_T value) { S->outputs[port].currentDims[dim] = value; }
+inline int_T HostCurrentWidth(const HostPort &port)
+{
+    int_T width = 1;
+    for (int_T d : port.currentDims)
+        width *= d;
+    return width;
+}
+inline int_T ssGetCurrentInputPortWidth(const SimStruct *S, int_T port) { return HostCurrentWidth(S->inputs[port]); }
+inline int_T ssGetCurrentOutputPortWidth(const SimStruct *S, int_T port) { return HostCurrentWidth(S->outputs[port]); }
+
+inline const void *ssGetInputPortSignal(const SimStruct *S, int_T port) { return S->inputs[port].signal; }
+inline InputPtrsType ssGetInputPortSignalPtrs(const SimStruct *S, int_T port) { return S->inputs[port].signalPtrs.data(); }
+inline InputRealPtrsType ssGetInputPortRealSignalPtrs(const SimStruct *S, int_T port)
+{
+    return reinterpret_cast<InputRealPtrsType>(S->inputs[port].signalPtrs.data());
+}
+inline const real_T *ssGetInputPortRealSignal(const SimStruct *S, int_T port) { return static_cast<const real_T *>(S->inputs[port].signal); }
+inline real_T *ssGetOutputPortRealSignal(const SimStruct *S, int_T port) { return static_cast<real_T *>(S->outputs[port].signal); }
+inline void *ssGetOutputPortSignal(const SimStruct *S, int_T port) { return S->outputs[port].signal; }
+
+/* parameters */
+inline void ssSetNumSFcnParams(SimStruct *S, int_T n) { S->numSFcnParams = n; }
+inline int_T ssGetNumSFcnParams(const SimStruct *S) { return S->numSFcnParams; }
+inline int_T ssGetSFcnParamsCount(const SimStruct *S) { return static_cast<int_T>(S->sfcnParams.size()); }
+inline const mxArray *ssGetSFcnParam(const SimStruct *S, int_T i)
+{
+    return i < static_cast<int_T>(S->sfcnParams.size()) ? S->sfcnParams[i] : nullptr;
+}
+inline void ssSetSFcnParamTunable(SimStruct *, int_T, int_T) {}
+
+/* sample times */
+inline void ssSetNumSampleTimes(SimStruct *S, int_T n)
+{
+    S->numSampleTimes = n;
+    S->sampleTimes.assign(n, INHERITED_SAMPLE_TIME);
+    S->offsetTimes.assign(n, 0.0);
+}
+inline void ssSetSampleTime(SimStruct *S, int_T i, time_T t) { S->sampleTimes[i] = t; }
+inline void ssSetOffsetTime(SimStruct *S, int_T i, time_T t) { S->offsetTimes[i] = t; }
+inline time_T ssGetSampleTime(const SimStruct *S, int_T i) { return S->sampleTimes[i]; }
+inline time_T ssGetT(const SimStruct *S) { return S->t; }
+inline time_T ssGetTaskTime(const SimStruct *S, int_T) { return S->t; }
+inline bool ssIsMajorTimeStep(const SimStruct *) { return true; }
+inline bool ssIsSampleHit(const SimStruct *, int_T, int_T) { return true; }
+
+/* work vectors */
+inline void ssSetNumRWork(SimStruct *S, int_T n) { S->rwork.assign(n, 0.0); }
+inline void ssSetNumIWork(SimStruct *S, int_T n) { S->iwork.assign(n, 0); }
+inline void ssSetNumPWork(SimStruct *S, int_T n) { S->pwork.assign(n, nullptr); }
+inline int_T ssGetNumRWork(const SimStruct *S) { return static_cast<int_T>(S->rwork.size()); }
+inline int_T ssGetNumIWork(const SimStruct *S) { return static_cast<int_T>(S->iwork.size()); }
+inline int_T ssGetNumPWork(const SimStruct *S) { return static_cast<int_T>(S->pwork.size()); }
+inline real_T *ssGetRWork(SimStruct *S) { return S->rwork.data(); }
+inline int_T *ssGetIWork(SimStruct *S) { return S->iwork.data(); }
+inline void **ssGetPWork(SimStruct *S) { return S->pwork.data(); }
+inline void ssSetNumModes(SimStruct *S, int_T n) { S->numModes = n; }
+inline void ssSetNumNonsampledZCs(SimStruct *S, int_T n) { S->numNonsampledZCs = n; }
+inline void ssSetNumContStates(SimStruct *S, int_T n)
+{
+    S->contStates.assign(n, 0.0);
+    S->derivatives.assign(n, 0.0);
+}
+inline void ssSetNumDiscStates(SimStruct *S, int_T n) { S->discStates.assign(n, 0.0); }
+inline int_T ssGetNumContStates(const SimStruct *S) { return static_cast<int_T>(S->contStates.size()); }
+inline int_T ssGetNumDiscStates(const SimStruct *S) { return static_cast<int_T>(S->discStates.size()); }
+inline real_T *ssGetContStates(SimStruct *S) { return S->contStates.data(); }
+inline real_T *ssGetdX(SimStruct *S) { return S->derivatives.data(); }
+inline real_T *ssGetRealDiscStates(SimStruct *S) { return S->discStates.data(); }
+inline void ssSetOptions(SimStruct *S, uint_T options) { S->options = options; }
+inline SS_SimMode ssGetSimMode(const SimStruct *) { return SS_SIMMODE_NORMAL; }
+
+#define SS_OPTION_EXCEPTION_FREE_CODE 0x1u
+#define SS_OPTION_WORKS_WITH_CODE_REUSE 0x2u
+#define SS_OPTION_USE_TLC_WITH_ACCELERATOR 0x4u
+#define SS_OPTION_ALLOW_INPUT_SCALAR_EXPANSION 0x8u
+
+/* diagnostics */
+inline void ssSetErrorStatus(SimStruct *S, const char *msg) { S->errorStatus = msg; }
+inline const char *ssGetErrorStatus(const SimStruct *S) { return S->errorStatus; }
+inline void ssWarning(SimStruct *S, const char *msg)
+{
+    S->lastWarning = msg;
+    ++S->numWarnings;
+}
+inline const char *ssGetModelName(const SimStruct *S) { return S->modelName; }
+inline const char *ssGetPath(const SimStruct *S) { return S->path; }
+#define ssPrintf printf
+
+// The stand-in registers half precision with this fixed id
+constexpr DTypeId HostHalfDataTypeId = 11;
+
+/* bus objects */
+
+struct HostBusElement
+{
+    std::string name;
+    DTypeId dataType;
+    int_T offset;
+    std::vector<int_T> dims;
+};
+
+struct HostBusType
+{
+    std::string name;
+    int_T size;
+    std::vector<HostBusElement> elements;
+};
+
+// Registered bus types get data type ids from here on
+constexpr DTypeId HostFirstBusDataTypeId = 100;
+
+/** Bus objects known to the stand-in, i.e. the "workspace" of ssRegisterTypeFromNamedObject(). */
+inline std::vector<HostBusType> &HostBusTypes()
+{
+    static std::vector<HostBusType> types;
+    return types;
+}
+
+/** Define (or replace) bus object name with the given size and element layout; returns its data type id. */
+inline DTypeId HostDefineBus(const char *name, int_T size, std::vector<HostBusElement> elements)
+{
+    std::vector<HostBusType> &types = HostBusTypes();
+    for (size_t i = 0; i < types.size(); ++i)
+    {
+        if (types[i].name == name)
+        {
+            types[i] = HostBusType{name, size, std::move(elements)};
+            return HostFirstBusDataTypeId + static_cast<DTypeId>(i);
+        }
+    }
+    types.push_back(HostBusType{name, size, std::move(elements)});
+    return HostFirstBusDataTypeId + static_cast<DTypeId>(types.size() - 1);
+}
+
+inline const HostBusType *HostGetBusType(DTypeId id)
+{
+    const std::vector<HostBusType> &types = HostBusTypes();
+    return id >= HostFirstBusDataTypeId && id - HostFirstBusDataTypeId < static_cast<DTypeId>(types.size()) ? &types[id - HostFirstBusDataTypeId] : nullptr;
+}
+
+inline int_T ssRegisterTypeFromNamedObject(SimStruct *, const char *name, DTypeId *id)
+{
+    const std::vector<HostBusType> &types = HostBusTypes();
+    for (size_t i = 0; i < types.size(); ++i)
+    {
+        if (types[i].name == name)
+        {
+            *id = HostFirstBusDataTypeId + static_cast<DTypeId>(i);
+            return 1;
+        }
+    }
+    *id = INVALID_DTYPE_ID;
+    return 0;
+}
+
+inline int_T ssIsDataTypeABus(const SimStruct *, DTypeId id) { return HostGetBusType(id) != nullptr; }
+inline int_T ssGetNumBusElements(const SimStruct *, DTypeId id) { return static_cast<int_T>(HostGetBusType(id)->elements.size()); }
+inline const char *ssGetBusElementName(const SimStruct *, DTypeId id, int_T i) { return HostGetBusType(id)->elements[i].name.c_str(); }
+inline DTypeId ssGetBusElementDataType(const SimStruct *, DTypeId id, int_T i) { return HostGetBusType(id)->elements[i].dataType; }
+inline int_T ssGetBusElementOffset(const SimStruct *, DTypeId id, int_T i) { return HostGetBusType(id)->elements[i].offset; }
+inline int_T ssGetBusElementNumDimensions(const SimStruct *, DTypeId id, int_T i) { return static_cast<int_T>(HostGetBusType(id)->elements[i].dims.size()); }
+inline const int_T *ssGetBusElementDimensions(const SimStruct *, DTypeId id, int_T i) { return HostGetBusType(id)->elements[i].dims.data(); }
+
+/** Size in bytes of a built-in data type, of half or of a bus */
+inline int_T ssGetDataTypeSize(const SimStruct *, DTypeId id)
+{
+    static const int_T sizes[] = {8, 4, 1, 1, 2, 2, 4, 4, 1, 8, 8, 2};
+    if (const HostBusType *bus = HostGetBusType(id))
+        return bus->size;
+    return (id >= 0 && id < static_cast<DTypeId>(sizeof(sizes) / sizeof(sizes[0]))) ? sizes[id] : 0;
+}
+
+inline DTypeId ssRegisterDataTypeHalfPrecision(SimStruct *, int_T) { return HostHalfDataTypeId; }
+
+inline DTypeId ssGetDataTypeId(const SimStruct *, const char *name)
+{
+    static const char *const names[] = {"double", "single", "int8", "uint8", "int16", "uint16",
+                                        "int32", "uint32", "boolean", "int64", "uint64", "half"};
+    for (DTypeId id = 0; id < static_cast<DTypeId>(sizeof(names) / sizeof(names[0])); ++id)
+    {
+        if (std::strcmp(names[id], name) == 0)
+            return id;
+    }
+    return INVALID_DTYPE_ID;
+}
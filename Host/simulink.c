@@ -0,0 +1,50 @@
+/*
+ * Host stand-in for MATLAB's simulink.c.
+ *
+ * An S-Function source ends with
+ *
+ *   #ifdef MATLAB_MEX_FILE
+ *   #include "simulink.c"
+ *   #else
+ *   #include "cg_sfun.h"
+ *   #endif
+ *
+ * Compiled with -DMATLAB_MEX_FILE and this directory on the include path,
+ * that include picks up this file, which exports the S-Function's (static)
+ * callbacks as HostSFunction_<S_FUNCTION_NAME>() for HostSimulation.
+ * The S-Function must be compiled as C++.
+ */
+
+#include "HostSimulation.hpp"
+
+#ifndef S_FUNCTION_NAME
+#error "S_FUNCTION_NAME must be defined before including simulink.c"
+#endif
+
+SFU_DECLARE_HOST_SFUNCTION(S_FUNCTION_NAME)
+{
+    HostSFunction sfunction;
+    sfunction.initializeSizes = mdlInitializeSizes;
+    sfunction.initializeSampleTimes = mdlInitializeSampleTimes;
+    sfunction.outputs = mdlOutputs;
+    sfunction.terminate = mdlTerminate;
+#ifdef MDL_SET_WORK_WIDTHS
+    sfunction.setWorkWidths = mdlSetWorkWidths;
+#endif
+#ifdef MDL_START
+    sfunction.start = mdlStart;
+#endif
+#ifdef MDL_INITIALIZE_CONDITIONS
+    sfunction.initializeConditions = mdlInitializeConditions;
+#endif
+#ifdef MDL_PROCESS_PARAMETERS
+    sfunction.processParameters = mdlProcessParameters;
+#endif
+#ifdef MDL_UPDATE
+    sfunction.update = mdlUpdate;
+#endif
+#ifdef MDL_DERIVATIVES
+    sfunction.derivatives = mdlDerivatives;
+#endif
+    return sfunction;
+}
@@ -1,19 +1,238 @@
 #pragma once
 
 #include "simstruc.h"
+#include "ErrorStatus.hpp"
+#include "Instrumentation.hpp"
+#include "DataTypes.hpp"
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
 #include <vector>
 #include <type_traits>
 
 /**
- * MATLAB requires error messages to be in persistent memory.
- * Since logically, only one error message can be active at any one time,
- * we store it in this variable.
+ * Non-owning view over a contiguous port buffer.
+ *
+ * The view points directly into Simulink's port memory, so no data is copied
+ * and nothing is allocated. It is only valid within the S-Function callback
+ * it was obtained in.
  */
-std::string errorMessageIO;
+template <typename T>
+class PortView
+{
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = size_t;
+    using iterator = T *;
+
+    constexpr PortView() noexcept = default;
+    constexpr PortView(T *data, size_t size) noexcept : data_(data), size_(size) {}
+
+    constexpr T *data() const noexcept { return data_; }
+    constexpr size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    constexpr T *begin() const noexcept { return data_; }
+    constexpr T *end() const noexcept { return data_ + size_; }
+
+    constexpr T &operator[](size_t index) const noexcept { return data_[index]; }
+
+private:
+    T *data_ = nullptr;
+    size_t size_ = 0;
+};
 
 template <typename T>
-void DefineInputPort(SimStruct *S, int portIndex, int rows = 1, int cols = 1, int isDirectFeedthrough = 0)
+using InputPortView = PortView<const T>;
+
+/** Storage order of a matrix view. Simulink ports are always ColumnMajor. */
+enum class MatrixLayout
+{
+    ColumnMajor,
+    RowMajor
+};
+
+/**
+ * Non-owning 2D view with a leading dimension, in either layout:
+ *
+ *   ColumnMajor: element (row, col) at data[row + col * leadingDimension]
+ *   RowMajor:    element (row, col) at data[row * leadingDimension + col]
+ *
+ * The transpose of a column-major matrix is the same memory read row-major,
+ * so transposed() and block() only change the indexing, never copy. A
+ * kernel written for either layout can work on the port buffer directly;
+ * data() and leadingDimension() are what BLAS/LAPACK style routines expect.
+ */
+template <typename T, MatrixLayout Layout = MatrixLayout::ColumnMajor>
+class StridedMatrixView
+{
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = size_t;
+
+    static constexpr MatrixLayout layout = Layout;
+
+    constexpr StridedMatrixView() noexcept = default;
+    constexpr StridedMatrixView(T *data, size_t rows, size_t cols, size_t leadingDimension) noexcept
+        : data_(data), rows_(rows), cols_(cols), leadingDimension_(leadingDimension) {}
+
+    constexpr T *data() const noexcept { return data_; }
+    constexpr size_t rows() const noexcept { return rows_; }
+    constexpr size_t cols() const noexcept { return cols_; }
+    constexpr size_t size() const noexcept { return rows_ * cols_; }
+    constexpr bool empty() const noexcept { return size() == 0; }
+    constexpr size_t leadingDimension() const noexcept { return leadingDimension_; }
+
+    // Element distance between (row, col) and (row + 1, col) / (row, col + 1)
+    constexpr size_t rowStride() const noexcept { return Layout == MatrixLayout::ColumnMajor ? 1 : leadingDimension_; }
+    constexpr size_t colStride() const noexcept { return Layout == MatrixLayout::ColumnMajor ? leadingDimension_ : 1; }
+
+    // True if the elements are packed without gaps, see flat()
+    constexpr bool contiguous() const noexcept { return leadingDimension_ == (Layout == MatrixLayout::ColumnMajor ? rows_ : cols_); }
+
+    constexpr T &operator()(size_t row, size_t col) const noexcept
+    {
+        if constexpr (Layout == MatrixLayout::ColumnMajor)
+            return data_[row + col * leadingDimension_];
+        else
+            return data_[row * leadingDimension_ + col];
+    }
+
+    /** Column col, contiguous in memory (column-major views only). */
+    constexpr PortView<T> column(size_t col) const noexcept
+    {
+        static_assert(Layout == MatrixLayout::ColumnMajor, "Only the columns of a column-major view are contiguous");
+        return PortView<T>(data_ + col * leadingDimension_, rows_);
+    }
+
+    /** Row row, contiguous in memory (row-major views only). */
+    constexpr PortView<T> row(size_t row) const noexcept
+    {
+        static_assert(Layout == MatrixLayout::RowMajor, "Only the rows of a row-major view are contiguous");
+        return PortView<T>(data_ + row * leadingDimension_, cols_);
+    }
+
+    /** All elements in storage order; only valid if contiguous(). */
+    constexpr PortView<T> flat() const noexcept { return PortView<T>(data_, size()); }
+
+    /** The rows x cols sub-matrix starting at (row, col), same memory. */
+    constexpr StridedMatrixView block(size_t row, size_t col, size_t rows, size_t cols) const noexcept
+    {
+        return StridedMatrixView(&(*this)(row, col), rows, cols, leadingDimension_);
+    }
+
+    /** The transpose, same memory in the other layout. */
+    constexpr auto transposed() const noexcept
+    {
+        constexpr MatrixLayout other = Layout == MatrixLayout::ColumnMajor ? MatrixLayout::RowMajor : MatrixLayout::ColumnMajor;
+        return StridedMatrixView<T, other>(data_, cols_, rows_, leadingDimension_);
+    }
+
+private:
+    T *data_ = nullptr;
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    size_t leadingDimension_ = 0;
+};
+
+template <typename T>
+using RowMajorMatrixView = StridedMatrixView<T, MatrixLayout::RowMajor>;
+
+/**
+ * Non-owning 2D view over a port buffer.
+ *
+ * Simulink stores matrices column-major, so element (row, col)
+ * lives at data[row + col * rows].
+ */
+template <typename T>
+class MatrixPortView
+{
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = size_t;
+
+    constexpr MatrixPortView() noexcept = default;
+    constexpr MatrixPortView(T *data, size_t rows, size_t cols) noexcept : data_(data), rows_(rows), cols_(cols) {}
+
+    constexpr T *data() const noexcept { return data_; }
+    constexpr size_t rows() const noexcept { return rows_; }
+    constexpr size_t cols() const noexcept { return cols_; }
+    constexpr size_t size() const noexcept { return rows_ * cols_; }
+    constexpr bool empty() const noexcept { return size() == 0; }
+
+    constexpr T &operator()(size_t row, size_t col) const noexcept { return data_[row + col * rows_]; }
+
+    // A single column is contiguous in memory
+    constexpr PortView<T> column(size_t col) const noexcept { return PortView<T>(data_ + col * rows_, rows_); }
+
+    // All elements in storage (column-major) order
+    constexpr PortView<T> flat() const noexcept { return PortView<T>(data_, size()); }
+
+    // Same matrix as a StridedMatrixView, e.g. to take a block()
+    constexpr StridedMatrixView<T> strided() const noexcept { return StridedMatrixView<T>(data_, rows_, cols_, rows_); }
+
+    // The cols x rows transpose, read row-major from the same memory
+    constexpr RowMajorMatrixView<T> transposed() const noexcept { return RowMajorMatrixView<T>(data_, cols_, rows_, rows_); }
+
+private:
+    T *data_ = nullptr;
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+};
+
+template <typename T>
+using InputMatrixView = MatrixPortView<const T>;
+
+/**
+ * Like MatrixPortView, but with dimensions known at compile time so loops
+ * over the port have a constant trip count. Rows x Cols, column-major;
+ * use Cols = 1 for vectors.
+ */
+template <typename T, size_t Rows, size_t Cols = 1>
+class FixedPortView
+{
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = size_t;
+    using iterator = T *;
+
+    constexpr FixedPortView() noexcept = default;
+    explicit constexpr FixedPortView(T *data) noexcept : data_(data) {}
+
+    static constexpr size_t rows() noexcept { return Rows; }
+    static constexpr size_t cols() noexcept { return Cols; }
+    static constexpr size_t size() noexcept { return Rows * Cols; }
+
+    constexpr T *data() const noexcept { return data_; }
+    constexpr T *begin() const noexcept { return data_; }
+    constexpr T *end() const noexcept { return data_ + Rows * Cols; }
+
+    constexpr T &operator[](size_t index) const noexcept { return data_[index]; }
+    constexpr T &operator()(size_t row, size_t col) const noexcept { return data_[row + col * Rows]; }
+
+    // The Cols x Rows transpose, read row-major from the same memory
+    constexpr RowMajorMatrixView<T> transposed() const noexcept { return RowMajorMatrixView<T>(data_, Cols, Rows, Rows); }
+
+private:
+    T *data_ = nullptr;
+};
+
+template <typename T>
+using OutputPortView = PortView<T>;
+
+template <typename T>
+using OutputMatrixView = MatrixPortView<T>;
+
+/**
+ * Define an input port of data type id dataType, e.g. DYNAMICALLY_TYPED for
+ * a port that takes the type of its source (see DataTypeDispatch).
+ */
+inline void DefineTypedInputPort(SimStruct *S, int portIndex, DTypeId dataType, int rows = 1, int cols = 1, int isDirectFeedthrough = 0)
 {
     // Check we have enough input ports (do not modify the number here)
     if (ssGetNumInputPorts(S) <= portIndex)
@@ -48,54 +267,19 @@ void DefineInputPort(SimStruct *S, int portIndex, int rows = 1, int cols = 1, in
     // }
     // ssSetInputPortDimensionInfo(S, 0, &di);
 
-    // Set data type based on template parameter T
-    if constexpr (std::is_same_v<T, uint8_T> || std::is_same_v<T, char_T>)
-    {
-        ssSetInputPortDataType(S, portIndex, SS_UINT8);
-    }
-    else if constexpr (std::is_same_v<T, int8_T>)
-    {
-        ssSetInputPortDataType(S, portIndex, SS_INT8);
-    }
-    else if constexpr (std::is_same_v<T, uint16_T>)
-    {
-        ssSetInputPortDataType(S, portIndex, SS_UINT16);
-    }
-    else if constexpr (std::is_same_v<T, int16_T>)
-    {
-        ssSetInputPortDataType(S, portIndex, SS_INT16);
-    }
-    else if constexpr (std::is_same_v<T, uint32_T>)
-    {
-        ssSetInputPortDataType(S, portIndex, SS_UINT32);
-    }
-    else if constexpr (std::is_same_v<T, int32_T>)
-    {
-        ssSetInputPortDataType(S, portIndex, SS_INT32);
-    }
-    else if constexpr (std::is_same_v<T, real32_T>)
-    {
-        ssSetInputPortDataType(S, portIndex, SS_SINGLE);
-    }
-    else if constexpr (std::is_same_v<T, real_T>)
-    {
-        ssSetInputPortDataType(S, portIndex, SS_DOUBLE);
-    }
-    else if constexpr (std::is_same_v<T, boolean_T> || std::is_same_v<T, bool>)
-    {
-        ssSetInputPortDataType(S, portIndex, SS_BOOLEAN);
-    }
-    else
-    {
-        // Default to double for unknown types
-        ssSetInputPortDataType(S, portIndex, SS_DOUBLE);
-    }
+    ssSetInputPortDataType(S, portIndex, dataType);
 
     // Set direct feedthrough
     ssSetInputPortDirectFeedThrough(S, portIndex, isDirectFeedthrough);
     ssSetInputPortRequiredContiguous(S, portIndex, 1);
 }
 
+template <typename T>
+void DefineInputPort(SimStruct *S, int portIndex, int rows = 1, int cols = 1, int isDirectFeedthrough = 0)
+{
+    DefineTypedInputPort(S, portIndex, DataTypeIdOf<T>(S), rows, cols, isDirectFeedthrough);
+}
+
 template <typename T>
 inline void DefineScalarInputPort(SimStruct *S, int portIndex, int isDirectFeedthrough = 0)
 {
@@ -114,8 +298,8 @@ inline void Define2DMatrixInputPort(SimStruct *S, int portIndex, int rows, int c
     DefineInputPort<T>(S, portIndex, rows, cols, isDirectFeedthrough);
 }
 
-template <typename T>
-void DefineOutputPort(SimStruct *S, int portIndex, int rows = 1, int cols = 1)
+/** Define an output port of data type id dataType, see DefineTypedInputPort(). */
+inline void DefineTypedOutputPort(SimStruct *S, int portIndex, DTypeId dataType, int rows = 1, int cols = 1)
 {
     // Check we have enough output ports (do not modify the number here)
     if (ssGetNumOutputPorts(S) <= portIndex)
@@ -152,48 +336,13 @@ void DefineOutputPort(SimStruct *S, int portIndex, int rows = 1, int cols = 1)
     // }
     // ssSetOutputPortDimensionInfo(S, 0, &di);
 
-    // Set data type based on template parameter T
-    if constexpr (std::is_same_v<T, uint8_T> || std::is_same_v<T, char_T>)
-    {
-        ssSetOutputPortDataType(S, portIndex, SS_UINT8);
-    }
-    else if constexpr (std::is_same_v<T, int8_T>)
-    {
-        ssSetOutputPortDataType(S, portIndex, SS_INT8);
-    }
-    else if constexpr (std::is_same_v<T, uint16_T>)
-    {
-        ssSetOutputPortDataType(S, portIndex, SS_UINT16);
-    }
-    else if constexpr (std::is_same_v<T, int16_T>)
-    {
-        ssSetOutputPortDataType(S, portIndex, SS_INT16);
-    }
-    else if constexpr (std::is_same_v<T, uint32_T>)
-    {
-        ssSetOutputPortDataType(S, portIndex, SS_UINT32);
-    }
-    else if constexpr (std::is_same_v<T, int32_T>)
-    {
-        ssSetOutputPortDataType(S, portIndex, SS_INT32);
-    }
-    else if constexpr (std::is_same_v<T, real32_T>)
-    {
-        ssSetOutputPortDataType(S, portIndex, SS_SINGLE);
-    }
-    else if constexpr (std::is_same_v<T, real_T>)
-    {
-        ssSetOutputPortDataType(S, portIndex, SS_DOUBLE);
-    }
-    else if constexpr (std::is_same_v<T, boolean_T> || std::is_same_v<T, bool>)
-    {
-        ssSetOutputPortDataType(S, portIndex, SS_BOOLEAN);
-    }
-    else
-    {
-        // Default to double for unknown types
-        ssSetOutputPortDataType(S, portIndex, SS_DOUBLE);
-    }
+    ssSetOutputPortDataType(S, portIndex, dataType);
+}
+
+template <typename T>
+void DefineOutputPort(SimStruct *S, int portIndex, int rows = 1, int cols = 1)
+{
+    DefineTypedOutputPort(S, portIndex, DataTypeIdOf<T>(S), rows, cols);
 }
 
 template <typename T>
@@ -220,16 +369,14 @@ inline T *GetOutputPortSignal(SimStruct *S, int portIndex, size_t size)
     // Check we have enough output ports
     if (ssGetNumOutputPorts(S) <= portIndex)
     {
-        errorMessageIO = "Insufficient number of output ports configured for Port " + std::to_string(portIndex);
-        ssSetErrorStatus(S, errorMessageIO.c_str());
+        SetErrorStatusf(S, "Insufficient number of output ports configured for Port %d", portIndex);
         return nullptr;
     }
 
     // Check if the output port width matches the expected width
     if (ssGetOutputPortWidth(S, portIndex) != size)
     {
-        errorMessageIO = "Output port width " + std::to_string(ssGetOutputPortWidth(S, portIndex)) + " does not match expected width " + std::to_string(size) + " for Port " + std::to_string(portIndex);
-        ssSetErrorStatus(S, errorMessageIO.c_str());
+        SetErrorStatusf(S, "Output port width %d does not match expected width %zu for Port %d", ssGetOutputPortWidth(S, portIndex), size, portIndex);
         return nullptr;
     }
 
@@ -237,17 +384,26 @@ inline T *GetOutputPortSignal(SimStruct *S, int portIndex, size_t size)
     // Check if outputSignal is valid
     if (!outputSignal)
     {
-        errorMessageIO = "Failed to get output port signal for port index " + std::to_string(portIndex);
-        ssWarning(S, errorMessageIO.c_str());
+        Warningf(S, "Failed to get output port signal for port index %d", portIndex);
         return nullptr;
     }
 
     return outputSignal;
 }
 
+namespace io_detail
+{
+    // 2-D ports have to be rows x cols, not just rows * cols wide; 1-D ports are only checked by width
+    inline bool MatrixDimensionsMatch(int_T numDims, const int_T *dims, size_t rows, size_t cols)
+    {
+        return numDims < 2 || ((size_t)dims[0] == rows && (size_t)dims[1] == cols);
+    }
+}
+
 template <typename T>
 void SetScalarOutputPort(SimStruct *S, int portIndex, T value)
 {
+    SFU_INSTRUMENT(S, OutputPorts);
     T *outputSignal = GetOutputPortSignal<T>(S, portIndex, 1);
     if (!outputSignal)
         return;
@@ -259,6 +415,7 @@ void SetScalarOutputPort(SimStruct *S, int portIndex, T value)
 template <typename T>
 void SetVectorOutputPort(SimStruct *S, int portIndex, const std::vector<T> &values)
 {
+    SFU_INSTRUMENT(S, OutputPorts);
     T *outputSignal = GetOutputPortSignal<T>(S, portIndex, values.size());
     if (!outputSignal)
         return;
@@ -270,6 +427,7 @@ void SetVectorOutputPort(SimStruct *S, int portIndex, const std::vector<T> &valu
 template <typename T>
 void SetVectorOutputPort(SimStruct *S, int portIndex, T *values, size_t size)
 {
+    SFU_INSTRUMENT(S, OutputPorts);
     T *outputSignal = GetOutputPortSignal<T>(S, portIndex, size);
     if (!outputSignal)
         return;
@@ -281,6 +439,7 @@ void SetVectorOutputPort(SimStruct *S, int portIndex, T *values, size_t size)
 template <typename T, size_t W>
 void SetVectorOutputPort(SimStruct *S, int portIndex, T *values)
 {
+    SFU_INSTRUMENT(S, OutputPorts);
     T *outputSignal = GetOutputPortSignal<T>(S, portIndex, W);
     if (!outputSignal)
         return;
@@ -292,6 +451,7 @@ void SetVectorOutputPort(SimStruct *S, int portIndex, T *values)
 template <typename T, size_t W>
 void SetVectorOutputPort(SimStruct *S, int portIndex, const T *values)
 {
+    SFU_INSTRUMENT(S, OutputPorts);
     T *outputSignal = GetOutputPortSignal<T>(S, portIndex, W);
     if (!outputSignal)
         return;
@@ -301,8 +461,9 @@ void SetVectorOutputPort(SimStruct *S, int portIndex, const T *values)
 }
 
 template <typename T, size_t W>
-void SetVectorOutputPort(SimStruct *S, int portIndex, std::array<T, W> values)
+void SetVectorOutputPort(SimStruct *S, int portIndex, const std::array<T, W> &values)
 {
+    SFU_INSTRUMENT(S, OutputPorts);
     T *outputSignal = GetOutputPortSignal<T>(S, portIndex, W);
     if (!outputSignal)
         return;
@@ -311,23 +472,42 @@ void SetVectorOutputPort(SimStruct *S, int portIndex, std::array<T, W> values)
     std::copy(values.begin(), values.end(), outputSignal);
 }
 
+/*
+ * The nested 2D overloads below and the Get2DMatrixInputPort ones take W
+ * columns of H rows each (a port of H rows x W cols) and index them
+ * values[col][row]. Each inner array is one column, which is contiguous in
+ * Simulink's column-major buffer, so they copy column by column without
+ * transposing. The flat T * overloads copy in storage (column-major) order.
+ */
+
 template <typename T>
-void Set2DMatrixOutputPort(SimStruct *S, int portIndex, std::vector<std::vector<T>> &values)
+void Set2DMatrixOutputPort(SimStruct *S, int portIndex, const std::vector<std::vector<T>> &values)
 {
-    T *outputSignal = GetOutputPortSignal<T>(S, portIndex, values.size() * values[0].size());
+    SFU_INSTRUMENT(S, OutputPorts);
+    const size_t rows = values.empty() ? 0 : values[0].size();
+    for (size_t i = 1; i < values.size(); ++i)
+    {
+        if (values[i].size() != rows)
+        {
+            SetErrorStatusf(S, "Column %zu has %zu rows instead of %zu for output port %d", i, values[i].size(), rows, portIndex);
+            return;
+        }
+    }
+    T *outputSignal = GetOutputPortSignal<T>(S, portIndex, values.size() * rows);
     if (!outputSignal)
         return;
 
-    // Set the output port values
+    // Set the output port values, one column at a time
     for (size_t i = 0; i < values.size(); ++i)
     {
-        std::copy(values[i].begin(), values[i].end(), outputSignal + i * values[i].size());
+        std::copy(values[i].begin(), values[i].end(), outputSignal + i * rows);
     }
 }
 
 template <typename T>
 void Set2DMatrixOutputPort(SimStruct *S, int portIndex, T *values, size_t rows, size_t cols)
 {
+    SFU_INSTRUMENT(S, OutputPorts);
     T *outputSignal = GetOutputPortSignal<T>(S, portIndex, rows * cols);
     if (!outputSignal)
         return;
@@ -338,6 +518,7 @@ void Set2DMatrixOutputPort(SimStruct *S, int portIndex, T *values, size_t rows,
 template <typename T, size_t W, size_t H>
 void Set2DMatrixOutputPort(SimStruct *S, int portIndex, T *values)
 {
+    SFU_INSTRUMENT(S, OutputPorts);
     T *outputSignal = GetOutputPortSignal<T>(S, portIndex, W * H);
     if (!outputSignal)
         return;
@@ -346,22 +527,24 @@ void Set2DMatrixOutputPort(SimStruct *S, int portIndex, T *values)
 }
 
 template <typename T, size_t W, size_t H>
-void Set2DMatrixOutputPort(SimStruct *S, int portIndex, std::array<std::array<T, W>, H> values)
+void Set2DMatrixOutputPort(SimStruct *S, int portIndex, const std::array<std::array<T, H>, W> &values)
 {
+    SFU_INSTRUMENT(S, OutputPorts);
     T *outputSignal = GetOutputPortSignal<T>(S, portIndex, W * H);
     if (!outputSignal)
         return;
 
-    // Set the output port values
-    for (size_t i = 0; i < H; ++i)
+    // Set the output port values, one column at a time
+    for (size_t i = 0; i < W; ++i)
     {
-        std::copy(values[i].begin(), values[i].end(), outputSignal + i * W);
+        std::copy(values[i].begin(), values[i].end(), outputSignal + i * H);
     }
 }
 
 template <typename T, size_t W, size_t H>
 void Set2DMatrixOutputPort(SimStruct *S, int portIndex, T **values)
 {
+    SFU_INSTRUMENT(S, OutputPorts);
     T *outputSignal = GetOutputPortSignal<T>(S, portIndex, W * H);
     if (!outputSignal)
         return;
@@ -376,6 +559,7 @@ void Set2DMatrixOutputPort(SimStruct *S, int portIndex, T **values)
 template <typename T, size_t W, size_t H>
 void Set2DMatrixOutputPort(SimStruct *S, int portIndex, T (&values)[W][H])
 {
+    SFU_INSTRUMENT(S, OutputPorts);
     T *outputSignal = GetOutputPortSignal<T>(S, portIndex, W * H);
     if (!outputSignal)
         return;
@@ -387,22 +571,52 @@ void Set2DMatrixOutputPort(SimStruct *S, int portIndex, T (&values)[W][H])
     }
 }
 
+/**
+ * Writable view over an output port buffer.
+ * Compute results directly into the view instead of filling a temporary
+ * container and handing it to SetVectorOutputPort().
+ */
+template <typename T>
+std::optional<OutputPortView<T>> GetVectorOutputPortView(SimStruct *S, int portIndex, size_t width)
+{
+    SFU_INSTRUMENT(S, OutputPorts);
+    T *outputSignal = GetOutputPortSignal<T>(S, portIndex, width);
+    if (!outputSignal)
+        return std::nullopt;
+
+    return OutputPortView<T>(outputSignal, width);
+}
+
+template <typename T>
+std::optional<OutputMatrixView<T>> Get2DMatrixOutputPortView(SimStruct *S, int portIndex, size_t rows, size_t cols)
+{
+    SFU_INSTRUMENT(S, OutputPorts);
+    T *outputSignal = GetOutputPortSignal<T>(S, portIndex, rows * cols);
+    if (!outputSignal)
+        return std::nullopt;
+    if (!io_detail::MatrixDimensionsMatch(ssGetOutputPortNumDimensions(S, portIndex), ssGetOutputPortDimensions(S, portIndex), rows, cols))
+    {
+        SetErrorStatusf(S, "Output port %d is %dx%d, not %zux%zu", portIndex, ssGetOutputPortDimensions(S, portIndex)[0], ssGetOutputPortDimensions(S, portIndex)[1], rows, cols);
+        return std::nullopt;
+    }
+
+    return OutputMatrixView<T>(outputSignal, rows, cols);
+}
+
 template <typename T>
 inline T *GetInputPortSignal(SimStruct *S, int portIndex, size_t size)
 {
     // Check we have enough input ports
     if (ssGetNumInputPorts(S) <= portIndex)
     {
-        errorMessageIO = "Insufficient number of input ports configured for Port " + std::to_string(portIndex);
-        ssSetErrorStatus(S, errorMessageIO.c_str());
+        SetErrorStatusf(S, "Insufficient number of input ports configured for Port %d", portIndex);
         return nullptr;
     }
 
     // Check if the input port width matches the expected width
     if (ssGetInputPortWidth(S, portIndex) != size)
     {
-        errorMessageIO = "Input port width " + std::to_string(ssGetInputPortWidth(S, portIndex)) + " does not match expected width " + std::to_string(size) + " for Port " + std::to_string(portIndex);
-        ssSetErrorStatus(S, errorMessageIO.c_str());
+        SetErrorStatusf(S, "Input port width %d does not match expected width %zu for Port %d", ssGetInputPortWidth(S, portIndex), size, portIndex);
         return nullptr;
     }
 
@@ -410,8 +624,7 @@ inline T *GetInputPortSignal(SimStruct *S, int portIndex, size_t size)
     T *inputSignal = (T *)ssGetInputPortSignal(S, portIndex);
     if (!inputSignal)
     {
-        errorMessageIO = "Failed to get input port signal for port index " + std::to_string(portIndex);
-        ssWarning(S, errorMessageIO.c_str());
+        Warningf(S, "Failed to get input port signal for port index %d", portIndex);
         return nullptr;
     }
 
@@ -421,6 +634,7 @@ inline T *GetInputPortSignal(SimStruct *S, int portIndex, size_t size)
 template <typename T>
 std::optional<T> GetScalarInputPort(SimStruct *S, int portIndex)
 {
+    SFU_INSTRUMENT(S, InputPorts);
     T *inputSignal = GetInputPortSignal<T>(S, portIndex, 1);
     if (!inputSignal)
         return std::nullopt;
@@ -432,6 +646,7 @@ std::optional<T> GetScalarInputPort(SimStruct *S, int portIndex)
 template <typename T>
 std::optional<std::vector<T>> GetVectorInputPort(SimStruct *S, int portIndex, size_t width)
 {
+    SFU_INSTRUMENT(S, InputPorts);
     T *inputSignal = GetInputPortSignal<T>(S, portIndex, width);
     if (!inputSignal)
         return std::nullopt;
@@ -448,6 +663,7 @@ std::optional<std::vector<T>> GetVectorInputPort(SimStruct *S, int portIndex, si
 template <typename T, size_t W>
 std::optional<std::array<T, W>> GetVectorInputPort(SimStruct *S, int portIndex)
 {
+    SFU_INSTRUMENT(S, InputPorts);
     T *inputSignal = GetInputPortSignal<T>(S, portIndex, W);
     if (!inputSignal)
         return std::nullopt;
@@ -461,6 +677,7 @@ std::optional<std::array<T, W>> GetVectorInputPort(SimStruct *S, int portIndex)
 template <typename T, size_t W>
 bool GetVectorInputPort(SimStruct *S, int portIndex, T *values)
 {
+    SFU_INSTRUMENT(S, InputPorts);
     T *inputSignal = GetInputPortSignal<T>(S, portIndex, W);
     if (!inputSignal)
         return false;
@@ -473,6 +690,7 @@ bool GetVectorInputPort(SimStruct *S, int portIndex, T *values)
 template <typename T>
 std::optional<std::vector<std::vector<T>>> Get2DMatrixInputPort(SimStruct *S, int portIndex, size_t width, size_t height)
 {
+    SFU_INSTRUMENT(S, InputPorts);
     T *inputSignal = GetInputPortSignal<T>(S, portIndex, width * height);
     if (!inputSignal)
         return std::nullopt;
@@ -494,6 +712,7 @@ std::optional<std::vector<std::vector<T>>> Get2DMatrixInputPort(SimStruct *S, in
 template <typename T, size_t W, size_t H>
 std::optional<std::array<std::array<T, H>, W>> Get2DMatrixInputPort(SimStruct *S, int portIndex)
 {
+    SFU_INSTRUMENT(S, InputPorts);
     T *inputSignal = GetInputPortSignal<T>(S, portIndex, W * H);
     if (!inputSignal)
         return std::nullopt;
@@ -510,6 +729,7 @@ std::optional<std::array<std::array<T, H>, W>> Get2DMatrixInputPort(SimStruct *S
 template <typename T, size_t W, size_t H>
 bool Get2DMatrixInputPort(SimStruct *S, int portIndex, T *values)
 {
+    SFU_INSTRUMENT(S, InputPorts);
     T *inputSignal = GetInputPortSignal<T>(S, portIndex, W * H);
     if (!inputSignal)
         return false;
@@ -523,6 +743,7 @@ bool Get2DMatrixInputPort(SimStruct *S, int portIndex, T *values)
 template <typename T, size_t W, size_t H>
 bool Get2DMatrixInputPort(SimStruct *S, int portIndex, T **values)
 {
+    SFU_INSTRUMENT(S, InputPorts);
     T *inputSignal = GetInputPortSignal<T>(S, portIndex, W * H);
     if (!inputSignal)
         return false;
@@ -539,6 +760,7 @@ bool Get2DMatrixInputPort(SimStruct *S, int portIndex, T **values)
 template <typename T, size_t W, size_t H>
 bool Get2DMatrixInputPort(SimStruct *S, int portIndex, T (&values)[W][H])
 {
+    SFU_INSTRUMENT(S, InputPorts);
     T *inputSignal = GetInputPortSignal<T>(S, portIndex, W * H);
     if (!inputSignal)
         return false;
@@ -555,6 +777,7 @@ bool Get2DMatrixInputPort(SimStruct *S, int portIndex, T (&values)[W][H])
 template <typename T, size_t W, size_t H>
 bool GetInputPort(SimStruct *S, int portIndex, T *output)
 {
+    SFU_INSTRUMENT(S, InputPorts);
     T *inputSignal = GetInputPortSignal<T>(S, portIndex, W * H);
     if (!inputSignal)
         return false;
@@ -568,6 +791,7 @@ bool GetInputPort(SimStruct *S, int portIndex, T *output)
 template <typename T>
 bool GetInputPort(SimStruct *S, int portIndex, T *output, size_t width = 1, size_t height = 1)
 {
+    SFU_INSTRUMENT(S, InputPorts);
     T *inputSignal = GetInputPortSignal<T>(S, portIndex, width * height);
     if (!inputSignal)
         return false;
@@ -576,4 +800,31 @@ bool GetInputPort(SimStruct *S, int portIndex, T *output, size_t width = 1, size
     std::copy(inputSignal, inputSignal + (width * height), output);
 
     return true;
-}
\ No newline at end of file
+}
+
+template <typename T>
+std::optional<InputPortView<T>> GetVectorInputPortView(SimStruct *S, int portIndex, size_t width)
+{
+    SFU_INSTRUMENT(S, InputPorts);
+    const T *inputSignal = GetInputPortSignal<T>(S, portIndex, width);
+    if (!inputSignal)
+        return std::nullopt;
+
+    return InputPortView<T>(inputSignal, width);
+}
+
+template <typename T>
+std::optional<InputMatrixView<T>> Get2DMatrixInputPortView(SimStruct *S, int portIndex, size_t rows, size_t cols)
+{
+    SFU_INSTRUMENT(S, InputPorts);
+    const T *inputSignal = GetInputPortSignal<T>(S, portIndex, rows * cols);
+    if (!inputSignal)
+        return std::nullopt;
+    if (!io_detail::MatrixDimensionsMatch(ssGetInputPortNumDimensions(S, portIndex), ssGetInputPortDimensions(S, portIndex), rows, cols))
+    {
+        SetErrorStatusf(S, "Input port %d is %dx%d, not %zux%zu", portIndex, ssGetInputPortDimensions(S, portIndex)[0], ssGetInputPortDimensions(S, portIndex)[1], rows, cols);
+        return std::nullopt;
+    }
+
+    return InputMatrixView<T>(inputSignal, rows, cols);
+}
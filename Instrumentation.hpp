@@ -0,0 +1,327 @@
+#pragma once
+
+#include "simstruc.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+/**
+ * Opt-in latency instrumentation of S-Function callbacks and of the port and
+ * parameter helpers. Compile with -DSFU_ENABLE_INSTRUMENTATION=1 and mark the
+ * callbacks to measure:
+ *
+ *   static void mdlOutputs(SimStruct *S, int_T tid)
+ *   {
+ *       SFU_INSTRUMENT(S, Outputs);
+ *       ...
+ *   }
+ *
+ *   static void mdlTerminate(SimStruct *S)
+ *   {
+ *       SFU_INSTRUMENT_TERMINATE(S); // prints p50 / p99 / max per probe
+ *   }
+ *
+ * The IO.hpp and Parameters.hpp helpers record into the InputPorts,
+ * OutputPorts and Parameters probes by themselves. Without
+ * SFU_ENABLE_INSTRUMENTATION all macros expand to nothing.
+ */
+#ifndef SFU_ENABLE_INSTRUMENTATION
+#define SFU_ENABLE_INSTRUMENTATION 0
+#endif
+
+// Number of S-Function instances that can be instrumented at the same time
+#ifndef SFU_INSTRUMENTATION_SLOT_COUNT
+#define SFU_INSTRUMENTATION_SLOT_COUNT 32
+#endif
+
+// Histogram resolution: 2^bits buckets per power of two, i.e. about 3% relative error for 5
+#ifndef SFU_INSTRUMENTATION_PRECISION_BITS
+#define SFU_INSTRUMENTATION_PRECISION_BITS 5
+#endif
+
+// Time with the CPU time stamp counter where available, otherwise steady_clock
+#ifndef SFU_INSTRUMENTATION_USE_TSC
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SFU_INSTRUMENTATION_USE_TSC 1
+#else
+#define SFU_INSTRUMENTATION_USE_TSC 0
+#endif
+#endif
+
+#if SFU_INSTRUMENTATION_USE_TSC
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+enum class InstrumentationProbe
+{
+    Outputs,
+    Update,
+    Derivatives,
+    InputPorts,
+    OutputPorts,
+    Parameters,
+    Count
+};
+
+inline const char *InstrumentationProbeName(InstrumentationProbe probe)
+{
+    static const char *const names[] = {"mdlOutputs", "mdlUpdate", "mdlDerivatives", "input ports", "output ports", "parameters"};
+    return names[static_cast<int>(probe)];
+}
+
+namespace instrumentation_detail
+{
+    inline uint64_t Ticks()
+    {
+#if SFU_INSTRUMENTATION_USE_TSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // Measured once against steady_clock when the first report is printed
+    inline double NanosecondsPerTick()
+    {
+#if SFU_INSTRUMENTATION_USE_TSC
+        static const double factor = []
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const uint64_t startTicks = Ticks();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            const uint64_t ticks = Ticks() - startTicks;
+            const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            return ticks ? ns / double(ticks) : 1.0;
+        }();
+        return factor;
+#else
+        return 1.0;
+#endif
+    }
+
+    inline int HighestBit(uint64_t value)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return static_cast<int>(index);
+#else
+        return 63 - __builtin_clzll(value);
+#endif
+    }
+}
+
+/**
+ * Fixed-size log-linear latency histogram in the style of HdrHistogram:
+ * values below 2 * SubBuckets are counted exactly, larger ones in
+ * SubBuckets buckets per power of two. Recording never allocates.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr int PrecisionBits = SFU_INSTRUMENTATION_PRECISION_BITS;
+    static constexpr uint64_t SubBuckets = uint64_t(1) << PrecisionBits;
+    static constexpr size_t BucketCount = size_t(65 - PrecisionBits) * SubBuckets;
+
+    void Record(uint64_t value) noexcept
+    {
+        ++counts_[BucketIndex(value)];
+        ++count_;
+        sum_ += value;
+        if (value > max_)
+            max_ = value;
+    }
+
+    void Reset() noexcept { *this = LatencyHistogram(); }
+
+    uint64_t count() const noexcept { return count_; }
+    uint64_t max() const noexcept { return max_; }
+    double mean() const noexcept { return count_ ? double(sum_) / double(count_) : 0.0; }
+
+    /** Smallest recorded value v such that a fraction p (0..1) of all values is <= v, up to bucket resolution. */
+    uint64_t Percentile(double p) const noexcept
+    {
+        if (count_ == 0)
+            return 0;
+        uint64_t rank = p >= 1.0 ? count_ : uint64_t(std::ceil(p * double(count_)));
+        if (rank == 0)
+            rank = 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BucketCount; ++i)
+        {
+            seen += counts_[i];
+            if (seen >= rank)
+                return BucketUpperBound(i) < max_ ? BucketUpperBound(i) : max_;
+        }
+        return max_;
+    }
+
+    static size_t BucketIndex(uint64_t value) noexcept
+    {
+        if (value < 2 * SubBuckets)
+            return size_t(value);
+        const int shift = instrumentation_detail::HighestBit(value) - PrecisionBits;
+        return size_t(shift) * SubBuckets + size_t(value >> shift);
+    }
+
+    static uint64_t BucketUpperBound(size_t index) noexcept
+    {
+        if (index < 2 * SubBuckets)
+            return index;
+        const int shift = int(index / SubBuckets) - 1;
+        const uint64_t top = index % SubBuckets + SubBuckets;
+        return ((top + 1) << shift) - 1;
+    }
+
+private:
+    uint32_t counts_[BucketCount] = {};
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t max_ = 0;
+};
+
+/**
+ * Histograms of one S-Function instance. Slots are claimed from a static
+ * table on first use, like the error message buffers, so instrumentation
+ * never allocates.
+ */
+struct InstrumentationSlot
+{
+    std::atomic<const SimStruct *> owner{nullptr};
+    LatencyHistogram histograms[static_cast<int>(InstrumentationProbe::Count)];
+};
+
+#if SFU_ENABLE_INSTRUMENTATION
+inline InstrumentationSlot instrumentationSlots[SFU_INSTRUMENTATION_SLOT_COUNT];
+#endif
+
+/** Histograms of S, or nullptr if instrumentation is disabled or all slots are taken. */
+inline InstrumentationSlot *GetInstrumentationSlot(const SimStruct *S)
+{
+#if SFU_ENABLE_INSTRUMENTATION
+    const size_t start = (size_t)((((uintptr_t)S >> 4) * 0x9E3779B97F4A7C15ull) % SFU_INSTRUMENTATION_SLOT_COUNT);
+    for (size_t probe = 0; probe < SFU_INSTRUMENTATION_SLOT_COUNT; ++probe)
+    {
+        InstrumentationSlot &slot = instrumentationSlots[(start + probe) % SFU_INSTRUMENTATION_SLOT_COUNT];
+        if (slot.owner.load(std::memory_order_acquire) == S)
+            return &slot;
+    }
+    for (size_t probe = 0; probe < SFU_INSTRUMENTATION_SLOT_COUNT; ++probe)
+    {
+        InstrumentationSlot &slot = instrumentationSlots[(start + probe) % SFU_INSTRUMENTATION_SLOT_COUNT];
+        const SimStruct *owner = nullptr;
+        if (slot.owner.compare_exchange_strong(owner, S, std::memory_order_acq_rel))
+        {
+            for (LatencyHistogram &histogram : slot.histograms)
+                histogram.Reset();
+            return &slot;
+        }
+    }
+#else
+    (void)S;
+#endif
+    return nullptr;
+}
+
+/** Give the slot of S back, e.g. at the end of mdlTerminate. */
+inline void ReleaseInstrumentationSlot(const SimStruct *S)
+{
+#if SFU_ENABLE_INSTRUMENTATION
+    for (InstrumentationSlot &slot : instrumentationSlots)
+    {
+        const SimStruct *owner = S;
+        slot.owner.compare_exchange_strong(owner, nullptr, std::memory_order_acq_rel);
+    }
+#else
+    (void)S;
+#endif
+}
+
+/**
+ * Print calls, mean, p50, p99 and max of every probe of S that was hit,
+ * with ssPrintf, or appended to the file path if given.
+ */
+inline void DumpInstrumentation(SimStruct *S, const char *path = nullptr)
+{
+    InstrumentationSlot *slot = GetInstrumentationSlot(S);
+    if (!slot)
+        return;
+    FILE *file = path ? std::fopen(path, "a") : nullptr;
+    if (path && !file)
+        return;
+
+    char line[256];
+    const double ns = instrumentation_detail::NanosecondsPerTick();
+    auto emit = [&](const char *text)
+    {
+        if (file)
+            std::fputs(text, file);
+        else
+            ssPrintf("%s", text);
+    };
+    std::snprintf(line, sizeof(line), "%s: latency in us\n%-14s %12s %10s %10s %10s %10s\n", ssGetPath(S),
+                  "probe", "calls", "mean", "p50", "p99", "max");
+    emit(line);
+    for (int probe = 0; probe < static_cast<int>(InstrumentationProbe::Count); ++probe)
+    {
+        const LatencyHistogram &histogram = slot->histograms[probe];
+        if (histogram.count() == 0)
+            continue;
+        std::snprintf(line, sizeof(line), "%-14s %12llu %10.3f %10.3f %10.3f %10.3f\n",
+                      InstrumentationProbeName(static_cast<InstrumentationProbe>(probe)),
+                      (unsigned long long)histogram.count(), histogram.mean() * ns * 1e-3,
+                      double(histogram.Percentile(0.50)) * ns * 1e-3, double(histogram.Percentile(0.99)) * ns * 1e-3,
+                      double(histogram.max()) * ns * 1e-3);
+        emit(line);
+    }
+    if (file)
+        std::fclose(file);
+}
+
+/** Records the time from construction to destruction into one probe of S. */
+class InstrumentationScope
+{
+public:
+    InstrumentationScope(const SimStruct *S, InstrumentationProbe probe)
+        : histogram_(nullptr), start_(0)
+    {
+        if (InstrumentationSlot *slot = GetInstrumentationSlot(S))
+        {
+            histogram_ = &slot->histograms[static_cast<int>(probe)];
+            start_ = instrumentation_detail::Ticks();
+        }
+    }
+
+    ~InstrumentationScope()
+    {
+        if (histogram_)
+            histogram_->Record(instrumentation_detail::Ticks() - start_);
+    }
+
+    InstrumentationScope(const InstrumentationScope &) = delete;
+    InstrumentationScope &operator=(const InstrumentationScope &) = delete;
+
+private:
+    LatencyHistogram *histogram_;
+    uint64_t start_;
+};
+
+#if SFU_ENABLE_INSTRUMENTATION
+#define SFU_INSTRUMENT(S, probe) InstrumentationScope sfuInstrumentationScope((S), InstrumentationProbe::probe)
+#ifdef SFU_INSTRUMENTATION_FILE
+#define SFU_INSTRUMENT_TERMINATE(S) (DumpInstrumentation((S), SFU_INSTRUMENTATION_FILE), ReleaseInstrumentationSlot(S))
+#else
+#define SFU_INSTRUMENT_TERMINATE(S) (DumpInstrumentation(S), ReleaseInstrumentationSlot(S))
+#endif
+#else
+#define SFU_INSTRUMENT(S, probe) ((void)0)
+#define SFU_INSTRUMENT_TERMINATE(S) ((void)0)
+#endif
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * A file mapped into memory, either created read-write with a fixed size
+ * (Create) or an existing file mapped read-only (Open).
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ~MappedFile() { Close(); }
+
+    /** Create (or replace) path with size bytes of disk space and map it read-write. */
+    bool Create(const char *path, size_t size)
+    {
+        Close();
+        if (size == 0)
+            return false;
+        // The size is passed on as a signed file offset
+#if defined(_WIN32)
+        if (size > static_cast<unsigned long long>(std::numeric_limits<LONGLONG>::max()))
+            return false;
+#else
+        if (size > static_cast<unsigned long long>(std::numeric_limits<off_t>::max()))
+            return false;
+#endif
+        writable_ = true;
+#if defined(_WIN32)
+        file_ = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER end;
+        end.QuadPart = static_cast<LONGLONG>(size);
+        if (!SetFilePointerEx(file_, end, nullptr, FILE_BEGIN) || !SetEndOfFile(file_))
+            return Fail();
+        return Map(size);
+#else
+        fd_ = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0)
+            return false;
+#if defined(__linux__)
+        // Reserve the blocks now, so a full disk fails here instead of with SIGBUS on a later write
+        if (posix_fallocate(fd_, 0, static_cast<off_t>(size)) != 0 && ftruncate(fd_, static_cast<off_t>(size)) != 0)
+            return Fail();
+#else
+        if (ftruncate(fd_, static_cast<off_t>(size)) != 0)
+            return Fail();
+#endif
+        return Map(size);
+#endif
+    }
+
+    /** Map an existing file read-only. */
+    bool Open(const char *path)
+    {
+        Close();
+        writable_ = false;
+#if defined(_WIN32)
+        file_ = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file_, &fileSize) || fileSize.QuadPart == 0)
+            return Fail();
+        return Map(static_cast<size_t>(fileSize.QuadPart));
+#else
+        fd_ = ::open(path, O_RDONLY);
+        if (fd_ < 0)
+            return false;
+        struct stat info;
+        if (fstat(fd_, &info) != 0 || info.st_size == 0)
+            return Fail();
+        return Map(static_cast<size_t>(info.st_size));
+#endif
+    }
+
+    /**
+     * Unmap and close. A writable file is cut to truncateTo bytes if that is
+     * smaller than its mapped size.
+     */
+    void Close(size_t truncateTo = SIZE_MAX)
+    {
+#if defined(_WIN32)
+        if (data_)
+            UnmapViewOfFile(data_);
+        if (mapping_)
+            CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE)
+        {
+            if (writable_ && truncateTo < size_)
+            {
+                LARGE_INTEGER end;
+                end.QuadPart = static_cast<LONGLONG>(truncateTo);
+                if (SetFilePointerEx(file_, end, nullptr, FILE_BEGIN))
+                    SetEndOfFile(file_);
+            }
+            CloseHandle(file_);
+        }
+        mapping_ = nullptr;
+        file_ = INVALID_HANDLE_VALUE;
+#else
+        if (data_)
+            munmap(data_, size_);
+        if (fd_ >= 0)
+        {
+            if (writable_ && truncateTo < size_)
+                (void)!ftruncate(fd_, static_cast<off_t>(truncateTo));
+            ::close(fd_);
+        }
+        fd_ = -1;
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    bool IsOpen() const noexcept { return data_ != nullptr; }
+    void *data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+
+private:
+    bool Map(size_t size)
+    {
+#if defined(_WIN32)
+        mapping_ = CreateFileMappingA(file_, nullptr, writable_ ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_)
+            return Fail();
+        data_ = MapViewOfFile(mapping_, writable_ ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size);
+        if (!data_)
+            return Fail();
+#else
+        void *data = mmap(nullptr, size, writable_ ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd_, 0);
+        if (data == MAP_FAILED)
+            return Fail();
+        data_ = data;
+#endif
+        size_ = size;
+        return true;
+    }
+
+    bool Fail()
+    {
+        Close();
+        return false;
+    }
+
+    void *data_ = nullptr;
+    size_t size_ = 0;
+    bool writable_ = false;
+#if defined(_WIN32)
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
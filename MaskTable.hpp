@@ -0,0 +1,319 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include "Parameters.hpp"
+
+/**
+ * Column types understood by the schema-driven extractSFunctionMaskTable().
+ */
+enum class MaskColumnType
+{
+    Double, // numeric cell, or a char cell containing a number
+    Int,    // as Double, stored as int32_t
+    Bool,   // numeric/logical cell (non-zero = true) or 'on'/'off'/'true'/'false'/'1'/'0'
+    Enum,   // char cell matching one of MaskColumnSpec::enumLabels, stored as its index
+    String  // char cell (numeric cells are formatted with %g)
+};
+
+struct MaskColumnSpec
+{
+    MaskColumnType type = MaskColumnType::String;
+    // Only used for MaskColumnType::Enum
+    std::vector<std::string> enumLabels;
+};
+
+class MaskTable;
+inline std::optional<MaskTable> extractSFunctionMaskTable(SimStruct *S, int paramIndex, const std::vector<MaskColumnSpec> &schema);
+
+/**
+ * One column of a MaskTable, decoded into a single contiguous typed array.
+ * Double columns use doubles(), Int and Enum columns ints(), Bool columns
+ * bools(). String columns store all characters in one buffer and are
+ * accessed through string(row).
+ */
+class MaskTableColumn
+{
+public:
+    MaskColumnType type() const { return type_; }
+
+    const double *doubles() const { return doubles_.data(); }
+    const int32_t *ints() const { return ints_.data(); }
+    const uint8_t *bools() const { return bools_.data(); }
+
+    std::string_view string(size_t row) const
+    {
+        return std::string_view(chars_.data() + offsets_[row], offsets_[row + 1] - offsets_[row] - 1);
+    }
+
+private:
+    friend std::optional<MaskTable> extractSFunctionMaskTable(SimStruct *S, int paramIndex, const std::vector<MaskColumnSpec> &schema);
+
+    MaskColumnType type_ = MaskColumnType::String;
+    std::vector<double> doubles_;
+    std::vector<int32_t> ints_;
+    std::vector<uint8_t> bools_;
+    // String columns: row i is chars_[offsets_[i], offsets_[i + 1] - 1), NUL-terminated
+    std::vector<char> chars_;
+    std::vector<uint32_t> offsets_;
+};
+
+/**
+ * Mask table decoded column by column (struct-of-arrays layout).
+ */
+class MaskTable
+{
+public:
+    size_t rows() const { return rows_; }
+    size_t cols() const { return columns_.size(); }
+    const MaskTableColumn &column(size_t col) const { return columns_[col]; }
+
+private:
+    friend std::optional<MaskTable> extractSFunctionMaskTable(SimStruct *S, int paramIndex, const std::vector<MaskColumnSpec> &schema);
+
+    size_t rows_ = 0;
+    std::vector<MaskTableColumn> columns_;
+};
+
+// Longest char cell decoded as a number, bool or enum label
+constexpr size_t MaskTableMaxTokenLength = 255;
+
+inline void maskTableCellError(SimStruct *S, int paramIndex, size_t row, size_t col, const char *problem)
+{
+    SetErrorStatusf(S, "Mask table cell (%zu, %zu) in parameter at index %d %s", row + 1, col + 1, paramIndex, problem);
+}
+
+/**
+ * Bytes mxGetString() needs for a char cell, without the terminating NUL.
+ * Non-ASCII characters take more than one byte in the multibyte encoding,
+ * so those cells are converted once to measure them. SIZE_MAX if the
+ * conversion fails.
+ */
+inline size_t maskTableStringLength(const mxArray *cell)
+{
+    const mxChar *chars = mxGetChars(cell);
+    const size_t count = mxGetNumberOfElements(cell);
+    if (chars == nullptr || std::all_of(chars, chars + count, [](mxChar c) { return c < 0x80; }))
+        return count;
+
+    char *converted = mxArrayToString(cell);
+    if (converted == nullptr)
+        return SIZE_MAX;
+    const size_t length = std::strlen(converted);
+    mxFree(converted);
+    return length;
+}
+
+inline bool decodeMaskTableNumber(const mxArray *cell, double &value)
+{
+    if (mxIsNumeric(cell) || mxIsLogical(cell))
+    {
+        if (mxGetNumberOfElements(cell) != 1)
+            return false;
+        value = mxGetScalar(cell);
+        return true;
+    }
+    char token[MaskTableMaxTokenLength + 1];
+    if (!mxIsChar(cell) || mxGetString(cell, token, sizeof(token)) != 0)
+        return false;
+    char *end = nullptr;
+    value = std::strtod(token, &end);
+    return end != token && *end == '\0';
+}
+
+inline bool decodeMaskTableBool(const mxArray *cell, uint8_t &value)
+{
+    if (mxIsNumeric(cell) || mxIsLogical(cell))
+    {
+        if (mxGetNumberOfElements(cell) != 1)
+            return false;
+        value = mxGetScalar(cell) != 0.0;
+        return true;
+    }
+    char token[MaskTableMaxTokenLength + 1];
+    if (!mxIsChar(cell) || mxGetString(cell, token, sizeof(token)) != 0)
+        return false;
+    if (!std::strcmp(token, "on") || !std::strcmp(token, "true") || !std::strcmp(token, "1"))
+        value = 1;
+    else if (!std::strcmp(token, "off") || !std::strcmp(token, "false") || !std::strcmp(token, "0"))
+        value = 0;
+    else
+        return false;
+    return true;
+}
+
+inline bool decodeMaskTableEnum(const mxArray *cell, const std::vector<std::string> &labels, int32_t &value)
+{
+    char token[MaskTableMaxTokenLength + 1];
+    if (!mxIsChar(cell) || mxGetString(cell, token, sizeof(token)) != 0)
+        return false;
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        if (labels[i] == token)
+        {
+            value = (int32_t)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Schema-driven variant of extractSFunctionMaskTable().
+ *
+ * Decodes each column straight into a typed contiguous array instead of a
+ * std::string per cell. schema must have one entry per table column.
+ * String columns are sized in a first pass, so every column allocates once
+ * (string columns: characters plus row offsets).
+ */
+inline std::optional<MaskTable> extractSFunctionMaskTable(SimStruct *S, int paramIndex, const std::vector<MaskColumnSpec> &schema)
+{
+    const mxArray *param = getSFunctionParameterChecked(S, paramIndex);
+    if (param == nullptr)
+        return std::nullopt;
+    if (!mxIsCell(param))
+    {
+        SetErrorStatusf(S, "Parameter at index %d is not a cell array but %s", paramIndex, mxGetClassName(param));
+        return std::nullopt;
+    }
+    const mwSize *dims = mxGetDimensions(param);
+    const size_t rows = dims[0];
+    const size_t cols = mxGetNumberOfElements(param) / (rows ? rows : 1);
+    if (rows != 0 && cols != schema.size())
+    {
+        SetErrorStatusf(S, "Mask table in parameter at index %d has %zu columns, but the schema describes %zu", paramIndex, cols, schema.size());
+        return std::nullopt;
+    }
+
+    MaskTable table;
+    table.rows_ = rows;
+    table.columns_.resize(schema.size());
+    for (size_t col = 0; col < schema.size(); ++col)
+    {
+        MaskTableColumn &column = table.columns_[col];
+        const MaskColumnSpec &spec = schema[col];
+        column.type_ = spec.type;
+        // Cells are stored column-major, so a table column is contiguous
+        const size_t first = col * rows;
+
+        switch (spec.type)
+        {
+        case MaskColumnType::Double:
+            column.doubles_.resize(rows);
+            for (size_t row = 0; row < rows; ++row)
+            {
+                const mxArray *cell = mxGetCell(param, first + row);
+                if (cell == nullptr || !decodeMaskTableNumber(cell, column.doubles_[row]))
+                {
+                    maskTableCellError(S, paramIndex, row, col, "is not a number");
+                    return std::nullopt;
+                }
+            }
+            break;
+
+        case MaskColumnType::Int:
+            column.ints_.resize(rows);
+            for (size_t row = 0; row < rows; ++row)
+            {
+                const mxArray *cell = mxGetCell(param, first + row);
+                double value;
+                if (cell == nullptr || !decodeMaskTableNumber(cell, value) || value != std::floor(value))
+                {
+                    maskTableCellError(S, paramIndex, row, col, "is not an integer");
+                    return std::nullopt;
+                }
+                // Also rejects +-inf, which pass the floor() check; the cast would be undefined
+                if (!(value >= (double)INT32_MIN && value <= (double)INT32_MAX))
+                {
+                    maskTableCellError(S, paramIndex, row, col, "is outside the int32 range");
+                    return std::nullopt;
+                }
+                column.ints_[row] = (int32_t)value;
+            }
+            break;
+
+        case MaskColumnType::Bool:
+            column.bools_.resize(rows);
+            for (size_t row = 0; row < rows; ++row)
+            {
+                const mxArray *cell = mxGetCell(param, first + row);
+                if (cell == nullptr || !decodeMaskTableBool(cell, column.bools_[row]))
+                {
+                    maskTableCellError(S, paramIndex, row, col, "is not a boolean");
+                    return std::nullopt;
+                }
+            }
+            break;
+
+        case MaskColumnType::Enum:
+            column.ints_.resize(rows);
+            for (size_t row = 0; row < rows; ++row)
+            {
+                const mxArray *cell = mxGetCell(param, first + row);
+                if (cell == nullptr || !decodeMaskTableEnum(cell, spec.enumLabels, column.ints_[row]))
+                {
+                    maskTableCellError(S, paramIndex, row, col, "is not one of the enumeration labels");
+                    return std::nullopt;
+                }
+            }
+            break;
+
+        case MaskColumnType::String:
+        {
+            // First pass: offsets, second pass: characters written in place
+            column.offsets_.resize(rows + 1);
+            size_t totalLength = 0;
+            for (size_t row = 0; row < rows; ++row)
+            {
+                const mxArray *cell = mxGetCell(param, first + row);
+                column.offsets_[row] = (uint32_t)totalLength;
+                if (cell != nullptr && mxIsChar(cell))
+                {
+                    const size_t length = maskTableStringLength(cell);
+                    if (length == SIZE_MAX)
+                    {
+                        maskTableCellError(S, paramIndex, row, col, "could not be converted");
+                        return std::nullopt;
+                    }
+                    totalLength += length + 1;
+                }
+                else if (cell != nullptr && (mxIsNumeric(cell) || mxIsLogical(cell)) && mxGetNumberOfElements(cell) == 1)
+                    totalLength += std::snprintf(nullptr, 0, "%g", mxGetScalar(cell)) + 1;
+                else
+                {
+                    maskTableCellError(S, paramIndex, row, col, "is not a string");
+                    return std::nullopt;
+                }
+            }
+            column.offsets_[rows] = (uint32_t)totalLength;
+            column.chars_.resize(totalLength);
+            for (size_t row = 0; row < rows; ++row)
+            {
+                const mxArray *cell = mxGetCell(param, first + row);
+                char *target = column.chars_.data() + column.offsets_[row];
+                const size_t capacity = column.offsets_[row + 1] - column.offsets_[row];
+                if (mxIsChar(cell))
+                {
+                    // Never keep a truncated string
+                    if (mxGetString(cell, target, capacity) != 0)
+                    {
+                        maskTableCellError(S, paramIndex, row, col, "could not be converted");
+                        return std::nullopt;
+                    }
+                }
+                else
+                    std::snprintf(target, capacity, "%g", mxGetScalar(cell));
+            }
+            break;
+        }
+        }
+    }
+    return table;
+}
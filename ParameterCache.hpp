@@ -0,0 +1,210 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "Parameters.hpp"
+
+/**
+ * Fingerprint of an mxArray's content: class, dimensions and data.
+ * Used by ParameterCache to find the parameters that actually changed.
+ * Cell arrays are hashed recursively. Classes whose data can't be read
+ * directly (e.g. structs) hash their address, so they are re-parsed
+ * whenever Simulink hands over a new array.
+ */
+inline uint64_t mxArrayFingerprint(const mxArray *array, uint64_t hash = 0xcbf29ce484222325ull)
+{
+    const uint64_t prime = 0x100000001b3ull;
+    auto mix = [&hash, prime](uint64_t word)
+    {
+        hash ^= word;
+        hash *= prime;
+        hash ^= hash >> 32;
+    };
+
+    if (array == nullptr)
+    {
+        mix(0);
+        return hash;
+    }
+
+    const mxClassID classID = mxGetClassID(array);
+    mix((uint64_t)classID);
+    const mwSize numDims = mxGetNumberOfDimensions(array);
+    const mwSize *dims = mxGetDimensions(array);
+    for (mwSize i = 0; i < numDims; ++i)
+        mix((uint64_t)dims[i]);
+
+    const mwSize numElements = mxGetNumberOfElements(array);
+    if (mxIsCell(array))
+    {
+        for (mwSize i = 0; i < numElements; ++i)
+            hash = mxArrayFingerprint(mxGetCell(array, i), hash);
+        return hash;
+    }
+    if (!mxIsNumeric(array) && !mxIsChar(array) && !mxIsLogical(array))
+    {
+        mix((uint64_t)(uintptr_t)array);
+        return hash;
+    }
+
+    // Hash the raw data eight bytes at a time
+    auto mixBytes = [&mix](const void *block, size_t numBytes)
+    {
+        const unsigned char *data = static_cast<const unsigned char *>(block);
+        size_t offset = 0;
+        for (; offset + sizeof(uint64_t) <= numBytes; offset += sizeof(uint64_t))
+        {
+            uint64_t word;
+            std::memcpy(&word, data + offset, sizeof(word));
+            mix(word);
+        }
+        if (offset < numBytes)
+        {
+            uint64_t word = 0;
+            std::memcpy(&word, data + offset, numBytes - offset);
+            mix(word);
+        }
+    };
+
+    // With interleaved complex the element size already covers both parts;
+    // otherwise mxGetData is only the real part and the imaginary part is separate
+    const size_t numBytes = numElements * mxGetElementSize(array);
+    mixBytes(mxGetData(array), numBytes);
+#if !MX_HAS_INTERLEAVED_COMPLEX
+    if (mxIsComplex(array))
+        mixBytes(mxGetImagData(array), numBytes);
+#endif
+    return hash;
+}
+
+/**
+ * Typed handle to a parameter declared in a ParameterCache.
+ */
+template <typename T>
+struct ParameterHandle
+{
+    size_t slot = 0;
+};
+
+/**
+ * Per-instance store of parsed S-Function parameters.
+ *
+ * Declare every parameter once, parse them all in mdlStart and re-parse in
+ * mdlProcessParameters; only parameters whose mxArray content changed are
+ * extracted again. Get() is a plain reference to the cached value, so it can
+ * be used from mdlOutputs without any per-step work:
+ *
+ *   ParameterHandle<double> gain = cache->Declare<double>(0);
+ *   ParameterHandle<std::vector<double>> table = cache->Declare<std::vector<double>>(1);
+ *   cache->Parse(S);
+ *   ...
+ *   y = cache->Get(gain) * u;
+ *
+ * Values are extracted with extractSFunctionParameter<T>(), so every type it
+ * supports can be cached.
+ */
+class ParameterCache
+{
+public:
+    template <typename T>
+    ParameterHandle<T> Declare(int paramIndex)
+    {
+        entries_.emplace_back(new Entry<T>(paramIndex));
+        return ParameterHandle<T>{entries_.size() - 1};
+    }
+
+    /**
+     * Parse all declared parameters. Call in mdlStart.
+     * Returns false (with the error status set) if any parameter is invalid.
+     */
+    bool Parse(SimStruct *S)
+    {
+        ClearChanged();
+        for (auto &entry : entries_)
+        {
+            if (!Reparse(S, *entry))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * Re-parse the parameters whose content changed since the last Parse()
+     * or Update(). Call in mdlProcessParameters.
+     */
+    bool Update(SimStruct *S)
+    {
+        ClearChanged();
+        for (auto &entry : entries_)
+        {
+            if (entry->valid && mxArrayFingerprint(ssGetSFcnParam(S, entry->paramIndex)) == entry->fingerprint)
+                continue;
+            if (!Reparse(S, *entry))
+                return false;
+        }
+        return true;
+    }
+
+    template <typename T>
+    const T &Get(ParameterHandle<T> handle) const
+    {
+        return static_cast<const Entry<T> &>(*entries_[handle.slot]).value;
+    }
+
+    /** Whether the parameter was (re-)parsed by the last Parse() / Update() */
+    template <typename T>
+    bool Changed(ParameterHandle<T> handle) const
+    {
+        return entries_[handle.slot]->changed;
+    }
+
+private:
+    struct EntryBase
+    {
+        explicit EntryBase(int paramIndex) : paramIndex(paramIndex) {}
+        virtual ~EntryBase() = default;
+        virtual bool Extract(SimStruct *S) = 0;
+
+        int paramIndex;
+        uint64_t fingerprint = 0;
+        bool valid = false;
+        bool changed = false;
+    };
+
+    template <typename T>
+    struct Entry : EntryBase
+    {
+        explicit Entry(int paramIndex) : EntryBase(paramIndex) {}
+
+        bool Extract(SimStruct *S) override
+        {
+            std::optional<T> parsed = extractSFunctionParameter<T>(S, paramIndex);
+            if (!parsed)
+                return false;
+            value = std::move(*parsed);
+            return true;
+        }
+
+        T value{};
+    };
+
+    // Entries after a failed one are not looked at, so they must not report an earlier change
+    void ClearChanged()
+    {
+        for (auto &entry : entries_)
+            entry->changed = false;
+    }
+
+    static bool Reparse(SimStruct *S, EntryBase &entry)
+    {
+        entry.valid = entry.Extract(S);
+        entry.changed = entry.valid;
+        if (!entry.valid)
+            return false;
+        entry.fingerprint = mxArrayFingerprint(ssGetSFcnParam(S, entry.paramIndex));
+        return true;
+    }
+
+    std::vector<std::unique_ptr<EntryBase>> entries_;
+};
@@ -1,56 +1,44 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <optional>
+#include <type_traits>
 #include "simstruc.h"
+#include "ErrorStatus.hpp"
+#include "Instrumentation.hpp"
 
 // Templated helper function to extract S-function parameters.
 // Returns std::nullopt on any error instead of a caller-provided default.
 template <typename T>
 std::optional<T> extractSFunctionParameter(SimStruct *S, int paramIndex);
 
-/**
- * MATLAB requires error messages to be in persistent memory.
- * Since logically, only one error message can be active at any one time,
- * we store it in this variable.
- */
-std::string errorMessageParameters;
-
 // Specialization for std::string
 template <>
 std::optional<std::string> extractSFunctionParameter<std::string>(SimStruct *S, int paramIndex)
 {
+    SFU_INSTRUMENT(S, Parameters);
     // Check if the number of configured parameters is sufficient
     if (ssGetNumSFcnParams(S) <= paramIndex)
     {
-        errorMessageParameters =
-            "Insufficient number of parameters set via ssSetNumSFcnParams().\n"
-            "Expected at least " +
-            std::to_string(paramIndex + 1) +
-            ", but got " + std::to_string(ssGetNumSFcnParams(S));
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
+        SetErrorStatusf(S, "Insufficient number of parameters set via ssSetNumSFcnParams().\nExpected at least %d, but got %d", paramIndex + 1, ssGetNumSFcnParams(S));
         return std::nullopt;
     }
     // Get parameter
     const mxArray *param = ssGetSFcnParam(S, paramIndex);
     if (param == nullptr)
     {
-        errorMessageParameters = "Parameter at index " + std::to_string(paramIndex) + " is null (not set?)";
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
+        SetErrorStatusf(S, "Parameter at index %d is null (not set?)", paramIndex);
         return std::nullopt;
     }
     if (!mxIsChar(param))
     {
-        errorMessageParameters = "Parameter at index " + std::to_string(paramIndex) + " is not a string but " + mxGetClassName(param);
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
+        SetErrorStatusf(S, "Parameter at index %d is not a string but %s", paramIndex, mxGetClassName(param));
         return std::nullopt;
     }
 
     // Get string length and allocate buffer
     const char *pCharArray = mxArrayToString(param);
-
-    printf("Extracted string parameter '%s'\n", pCharArray);
-
     std::string result(pCharArray);
     // Free temporary buffer
     mxFree((void *)pCharArray);
@@ -61,36 +49,29 @@ std::optional<std::string> extractSFunctionParameter<std::string>(SimStruct *S,
 template <>
 std::optional<int> extractSFunctionParameter<int>(SimStruct *S, int paramIndex)
 {
+    SFU_INSTRUMENT(S, Parameters);
     // Check if the number of configured parameters is sufficient
     if (ssGetNumSFcnParams(S) <= paramIndex)
     {
-        errorMessageParameters =
-            "Insufficient number of parameters set via ssSetNumSFcnParams().\n"
-            "Expected at least " +
-            std::to_string(paramIndex + 1) +
-            ", but got " + std::to_string(ssGetNumSFcnParams(S));
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
+        SetErrorStatusf(S, "Insufficient number of parameters set via ssSetNumSFcnParams().\nExpected at least %d, but got %d", paramIndex + 1, ssGetNumSFcnParams(S));
         return std::nullopt;
     }
     const mxArray *param = ssGetSFcnParam(S, paramIndex);
     if (param == nullptr)
     {
-        errorMessageParameters = "Parameter at index " + std::to_string(paramIndex) + " is null (not set?)";
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
+        SetErrorStatusf(S, "Parameter at index %d is null (not set?)", paramIndex);
         return std::nullopt;
     }
     if (!mxIsNumeric(param) || mxGetNumberOfElements(param) != 1)
     {
         if (!mxIsNumeric(param))
         {
-            errorMessageParameters = "Parameter at index " + std::to_string(paramIndex) + " is not numeric but " + mxGetClassName(param);
-            ssSetErrorStatus(S, errorMessageParameters.c_str());
+            SetErrorStatusf(S, "Parameter at index %d is not numeric but %s", paramIndex, mxGetClassName(param));
             return std::nullopt;
         }
         if (mxGetNumberOfElements(param) != 1)
         {
-            errorMessageParameters = "Parameter at index " + std::to_string(paramIndex) + " must be a scalar (1 element) but has " + std::to_string(mxGetNumberOfElements(param));
-            ssSetErrorStatus(S, errorMessageParameters.c_str());
+            SetErrorStatusf(S, "Parameter at index %d must be a scalar (1 element) but has %zu", paramIndex, (size_t)mxGetNumberOfElements(param));
             return std::nullopt;
         }
     }
@@ -101,35 +82,28 @@ std::optional<int> extractSFunctionParameter<int>(SimStruct *S, int paramIndex)
 template <>
 std::optional<double> extractSFunctionParameter<double>(SimStruct *S, int paramIndex)
 {
+    SFU_INSTRUMENT(S, Parameters);
     if (ssGetNumSFcnParams(S) <= paramIndex)
     {
-        errorMessageParameters =
-            "Insufficient number of parameters set via ssSetNumSFcnParams().\n"
-            "Expected at least " +
-            std::to_string(paramIndex + 1) +
-            ", but got " + std::to_string(ssGetNumSFcnParams(S));
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
+        SetErrorStatusf(S, "Insufficient number of parameters set via ssSetNumSFcnParams().\nExpected at least %d, but got %d", paramIndex + 1, ssGetNumSFcnParams(S));
         return std::nullopt;
     }
     const mxArray *param = ssGetSFcnParam(S, paramIndex);
     if (param == nullptr)
     {
-        errorMessageParameters = "Parameter at index " + std::to_string(paramIndex) + " is null (not set?)";
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
+        SetErrorStatusf(S, "Parameter at index %d is null (not set?)", paramIndex);
         return std::nullopt;
     }
     if (!mxIsNumeric(param) || mxGetNumberOfElements(param) != 1)
     {
         if (!mxIsNumeric(param))
         {
-            errorMessageParameters = "Parameter at index " + std::to_string(paramIndex) + " is not numeric but " + mxGetClassName(param);
-            ssSetErrorStatus(S, errorMessageParameters.c_str());
+            SetErrorStatusf(S, "Parameter at index %d is not numeric but %s", paramIndex, mxGetClassName(param));
             return std::nullopt;
         }
         if (mxGetNumberOfElements(param) != 1)
         {
-            errorMessageParameters = "Parameter at index " + std::to_string(paramIndex) + " must be a scalar (1 element) but has " + std::to_string(mxGetNumberOfElements(param));
-            ssSetErrorStatus(S, errorMessageParameters.c_str());
+            SetErrorStatusf(S, "Parameter at index %d must be a scalar (1 element) but has %zu", paramIndex, (size_t)mxGetNumberOfElements(param));
             return std::nullopt;
         }
     }
@@ -140,142 +114,249 @@ std::optional<double> extractSFunctionParameter<double>(SimStruct *S, int paramI
 template <>
 std::optional<bool> extractSFunctionParameter<bool>(SimStruct *S, int paramIndex)
 {
+    SFU_INSTRUMENT(S, Parameters);
     if (ssGetNumSFcnParams(S) <= paramIndex)
     {
-        errorMessageParameters =
-            "Insufficient number of parameters set via ssSetNumSFcnParams().\n"
-            "Expected at least " +
-            std::to_string(paramIndex + 1) +
-            ", but got " + std::to_string(ssGetNumSFcnParams(S));
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
+        SetErrorStatusf(S, "Insufficient number of parameters set via ssSetNumSFcnParams().\nExpected at least %d, but got %d", paramIndex + 1, ssGetNumSFcnParams(S));
         return std::nullopt;
     }
     const mxArray *param = ssGetSFcnParam(S, paramIndex);
     if (param == nullptr)
     {
-        errorMessageParameters = "Parameter at index " + std::to_string(paramIndex) + " is null (not set?)";
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
+        SetErrorStatusf(S, "Parameter at index %d is null (not set?)", paramIndex);
         return std::nullopt;
     }
     if (!mxIsNumeric(param) || mxGetNumberOfElements(param) != 1)
     {
         if (!mxIsNumeric(param))
         {
-            errorMessageParameters = "Parameter at index " + std::to_string(paramIndex) + " is not numeric but " + mxGetClassName(param);
-            ssSetErrorStatus(S, errorMessageParameters.c_str());
+            SetErrorStatusf(S, "Parameter at index %d is not numeric but %s", paramIndex, mxGetClassName(param));
             return std::nullopt;
         }
         if (mxGetNumberOfElements(param) != 1)
         {
-            errorMessageParameters = "Parameter at index " + std::to_string(paramIndex) + " must be a scalar (1 element) but has " + std::to_string(mxGetNumberOfElements(param));
-            ssSetErrorStatus(S, errorMessageParameters.c_str());
+            SetErrorStatusf(S, "Parameter at index %d must be a scalar (1 element) but has %zu", paramIndex, (size_t)mxGetNumberOfElements(param));
             return std::nullopt;
         }
     }
     return static_cast<bool>(mxGetScalar(param));
 }
 
-// Specialization for std::vector<int>
-template <>
-std::optional<std::vector<int>> extractSFunctionParameter<std::vector<int>>(SimStruct *S, int paramIndex)
+/**
+ * MATLAB class ID corresponding to the C++ type T, or mxUNKNOWN_CLASS.
+ */
+template <typename T>
+constexpr mxClassID mxClassIdOf()
+{
+    if constexpr (std::is_same_v<T, double>)
+        return mxDOUBLE_CLASS;
+    else if constexpr (std::is_same_v<T, float>)
+        return mxSINGLE_CLASS;
+    else if constexpr (std::is_same_v<T, bool>)
+        return mxLOGICAL_CLASS;
+    else if constexpr (std::is_integral_v<T> && sizeof(T) == 1)
+        return std::is_signed_v<T> ? mxINT8_CLASS : mxUINT8_CLASS;
+    else if constexpr (std::is_integral_v<T> && sizeof(T) == 2)
+        return std::is_signed_v<T> ? mxINT16_CLASS : mxUINT16_CLASS;
+    else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
+        return std::is_signed_v<T> ? mxINT32_CLASS : mxUINT32_CLASS;
+    else if constexpr (std::is_integral_v<T> && sizeof(T) == 8)
+        return std::is_signed_v<T> ? mxINT64_CLASS : mxUINT64_CLASS;
+    else
+        return mxUNKNOWN_CLASS;
+}
+
+/**
+ * Read-only view of a numeric parameter's data, without copying.
+ * Matrices are column-major, as in MATLAB. The view is valid until
+ * Simulink replaces the parameter (see mdlProcessParameters).
+ */
+template <typename T>
+class ParamView
+{
+public:
+    using value_type = T;
+    using iterator = const T *;
+
+    ParamView() = default;
+    ParamView(const T *data, size_t rows, size_t cols) : data_(data), rows_(rows), cols_(cols) {}
+
+    const T *data() const { return data_; }
+    size_t size() const { return rows_ * cols_; }
+    bool empty() const { return size() == 0; }
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+
+    const T *begin() const { return data_; }
+    const T *end() const { return data_ + size(); }
+
+    const T &operator[](size_t index) const { return data_[index]; }
+    const T &operator()(size_t row, size_t col) const { return data_[row + col * rows_]; }
+
+private:
+    const T *data_ = nullptr;
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+};
+
+/**
+ * Get parameter paramIndex after checking the parameter count and that it is set.
+ * Returns nullptr and sets the error status otherwise.
+ */
+inline const mxArray *getSFunctionParameterChecked(SimStruct *S, int paramIndex)
 {
     if (ssGetNumSFcnParams(S) <= paramIndex)
     {
-        errorMessageParameters =
-            "Insufficient number of parameters set via ssSetNumSFcnParams().\n"
-            "Expected at least " +
-            std::to_string(paramIndex + 1) +
-            ", but got " + std::to_string(ssGetNumSFcnParams(S));
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
-        return std::nullopt;
+        SetErrorStatusf(S, "Insufficient number of parameters set via ssSetNumSFcnParams().\nExpected at least %d, but got %d", paramIndex + 1, ssGetNumSFcnParams(S));
+        return nullptr;
     }
     const mxArray *param = ssGetSFcnParam(S, paramIndex);
     if (param == nullptr)
     {
-        errorMessageParameters = "Parameter at index " + std::to_string(paramIndex) + " is null (not set?)";
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
-        return std::nullopt;
+        SetErrorStatusf(S, "Parameter at index %d is null (not set?)", paramIndex);
+        return nullptr;
     }
-    if (!mxIsNumeric(param))
-    {
-        errorMessageParameters = "Parameter at index " + std::to_string(paramIndex) + " is not a numeric array but " + mxGetClassName(param);
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
+    return param;
+}
+
+/**
+ * Zero-copy view of a numeric parameter whose MATLAB class matches T exactly
+ * (e.g. ParamView<int32_T> requires an int32 parameter). Use
+ * extractSFunctionParameterVector<T>() to convert parameters of other classes.
+ */
+template <typename T>
+std::optional<ParamView<T>> extractSFunctionParameterView(SimStruct *S, int paramIndex)
+{
+    SFU_INSTRUMENT(S, Parameters);
+    static_assert(mxClassIdOf<T>() != mxUNKNOWN_CLASS, "ParamView<T> requires a numeric or logical T");
+
+    const mxArray *param = getSFunctionParameterChecked(S, paramIndex);
+    if (param == nullptr)
         return std::nullopt;
-    }
-    mwSize numElements = mxGetNumberOfElements(param);
-    std::vector<int> result;
-    result.reserve(numElements);
-    double *data = mxGetPr(param);
-    for (mwSize i = 0; i < numElements; ++i)
+    if (mxGetClassID(param) != mxClassIdOf<T>() || mxIsComplex(param))
     {
-        result.push_back(static_cast<int>(data[i]));
+        SetErrorStatusf(S, "Parameter at index %d has class %s%s, which does not match the requested element type", paramIndex, mxIsComplex(param) ? "complex " : "", mxGetClassName(param));
+        return std::nullopt;
     }
-    return result;
+    const size_t rows = mxGetM(param);
+    const size_t cols = rows ? mxGetNumberOfElements(param) / rows : 0;
+    return ParamView<T>(static_cast<const T *>(mxGetData(param)), rows, cols);
 }
 
-// Specialization for std::vector<double>
-template <>
-std::optional<std::vector<double>> extractSFunctionParameter<std::vector<double>>(SimStruct *S, int paramIndex)
+template <typename Source, typename T>
+inline void convertParameterData(const void *data, size_t count, T *values)
 {
-    if (ssGetNumSFcnParams(S) <= paramIndex)
+    // Plain element-wise conversion, vectorised by the compiler
+    const Source *source = static_cast<const Source *>(data);
+    for (size_t i = 0; i < count; ++i)
+        values[i] = static_cast<T>(source[i]);
+}
+
+/**
+ * Convert all elements of a real numeric or logical mxArray to T.
+ * values must have room for mxGetNumberOfElements(param) elements.
+ * Returns false for unsupported classes.
+ */
+template <typename T>
+bool convertMxArrayData(const mxArray *param, T *values)
+{
+    if (mxIsComplex(param))
+        return false;
+
+    const void *data = mxGetData(param);
+    const size_t count = mxGetNumberOfElements(param);
+    switch (mxGetClassID(param))
     {
-        errorMessageParameters =
-            "Insufficient number of parameters set via ssSetNumSFcnParams().\n"
-            "Expected at least " +
-            std::to_string(paramIndex + 1) +
-            ", but got " + std::to_string(ssGetNumSFcnParams(S));
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
-        return std::nullopt;
+    case mxDOUBLE_CLASS:
+        convertParameterData<double>(data, count, values);
+        return true;
+    case mxSINGLE_CLASS:
+        convertParameterData<float>(data, count, values);
+        return true;
+    case mxINT8_CLASS:
+        convertParameterData<int8_t>(data, count, values);
+        return true;
+    case mxUINT8_CLASS:
+    case mxLOGICAL_CLASS:
+        convertParameterData<uint8_t>(data, count, values);
+        return true;
+    case mxINT16_CLASS:
+        convertParameterData<int16_t>(data, count, values);
+        return true;
+    case mxUINT16_CLASS:
+        convertParameterData<uint16_t>(data, count, values);
+        return true;
+    case mxINT32_CLASS:
+        convertParameterData<int32_t>(data, count, values);
+        return true;
+    case mxUINT32_CLASS:
+        convertParameterData<uint32_t>(data, count, values);
+        return true;
+    case mxINT64_CLASS:
+        convertParameterData<int64_t>(data, count, values);
+        return true;
+    case mxUINT64_CLASS:
+        convertParameterData<uint64_t>(data, count, values);
+        return true;
+    default:
+        return false;
     }
-    const mxArray *param = ssGetSFcnParam(S, paramIndex);
+}
+
+/**
+ * Extract a numeric parameter of any real numeric class as std::vector<T>,
+ * converting each element with static_cast.
+ */
+template <typename T>
+std::optional<std::vector<T>> extractSFunctionParameterVector(SimStruct *S, int paramIndex)
+{
+    SFU_INSTRUMENT(S, Parameters);
+    const mxArray *param = getSFunctionParameterChecked(S, paramIndex);
     if (param == nullptr)
-    {
-        errorMessageParameters = "Parameter at index " + std::to_string(paramIndex) + " is null (not set?)";
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
         return std::nullopt;
-    }
-    if (!mxIsNumeric(param))
+    if ((!mxIsNumeric(param) && !mxIsLogical(param)) || mxIsComplex(param))
     {
-        errorMessageParameters = "Parameter at index " + std::to_string(paramIndex) + " is not a numeric array but " + mxGetClassName(param);
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
+        SetErrorStatusf(S, "Parameter at index %d is not a real numeric array but %s", paramIndex, mxGetClassName(param));
         return std::nullopt;
     }
-    mwSize numElements = mxGetNumberOfElements(param);
-    std::vector<double> result;
-    result.reserve(numElements);
-    double *data = mxGetPr(param);
-    for (mwSize i = 0; i < numElements; ++i)
-    {
-        result.push_back(data[i]);
-    }
+    std::vector<T> result(mxGetNumberOfElements(param));
+    convertMxArrayData(param, result.data());
     return result;
 }
 
+// Specialization for std::vector<int>
+template <>
+std::optional<std::vector<int>> extractSFunctionParameter<std::vector<int>>(SimStruct *S, int paramIndex)
+{
+    return extractSFunctionParameterVector<int>(S, paramIndex);
+}
+
+// Specialization for std::vector<double>
+template <>
+std::optional<std::vector<double>> extractSFunctionParameter<std::vector<double>>(SimStruct *S, int paramIndex)
+{
+    return extractSFunctionParameterVector<double>(S, paramIndex);
+}
+
 // Specialization for std::vector<std::string>
 template <>
 std::optional<std::vector<std::string>> extractSFunctionParameter<std::vector<std::string>>(SimStruct *S, int paramIndex)
 {
+    SFU_INSTRUMENT(S, Parameters);
     if (ssGetNumSFcnParams(S) <= paramIndex)
     {
-        errorMessageParameters =
-            "Insufficient number of parameters set via ssSetNumSFcnParams().\n"
-            "Expected at least " +
-            std::to_string(paramIndex + 1) +
-            ", but got " + std::to_string(ssGetNumSFcnParams(S));
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
+        SetErrorStatusf(S, "Insufficient number of parameters set via ssSetNumSFcnParams().\nExpected at least %d, but got %d", paramIndex + 1, ssGetNumSFcnParams(S));
         return std::nullopt;
     }
     const mxArray *param = ssGetSFcnParam(S, paramIndex);
     if (param == nullptr)
     {
-        errorMessageParameters = "Parameter at index " + std::to_string(paramIndex) + " is null (not set?)";
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
+        SetErrorStatusf(S, "Parameter at index %d is null (not set?)", paramIndex);
         return std::nullopt;
     }
     if (!mxIsCell(param))
     {
-        errorMessageParameters = "Parameter at index " + std::to_string(paramIndex) + " is not a cell array but " + mxGetClassName(param);
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
+        SetErrorStatusf(S, "Parameter at index %d is not a cell array but %s", paramIndex, mxGetClassName(param));
         return std::nullopt;
     }
     mwSize numElements = mxGetNumberOfElements(param);
@@ -286,15 +367,13 @@ std::optional<std::vector<std::string>> extractSFunctionParameter<std::vector<st
         const mxArray *cellElement = mxGetCell(param, i);
         if (cellElement == nullptr || !mxIsChar(cellElement))
         {
-            errorMessageParameters = "Cell element " + std::to_string(i) + " in parameter at index " + std::to_string(paramIndex) + " is not a string";
-            ssSetErrorStatus(S, errorMessageParameters.c_str());
+            SetErrorStatusf(S, "Cell element %zu in parameter at index %d is not a string", (size_t)i, paramIndex);
             return std::nullopt;
         }
         char *nameBuffer = mxArrayToString(cellElement);
         if (nameBuffer == nullptr)
         {
-            errorMessageParameters = "Failed to convert cell element " + std::to_string(i) + " to string in parameter at index " + std::to_string(paramIndex);
-            ssSetErrorStatus(S, errorMessageParameters.c_str());
+            SetErrorStatusf(S, "Failed to convert cell element %zu to string in parameter at index %d", (size_t)i, paramIndex);
             return std::nullopt;
         }
         result.emplace_back(nameBuffer);
@@ -305,27 +384,21 @@ std::optional<std::vector<std::string>> extractSFunctionParameter<std::vector<st
 
 std::optional<std::vector<std::vector<std::string>>> extractSFunctionMaskTable(SimStruct *S, int paramIndex)
 {
+    SFU_INSTRUMENT(S, Parameters);
     if (ssGetNumSFcnParams(S) <= paramIndex)
     {
-        errorMessageParameters =
-            "Insufficient number of parameters set via ssSetNumSFcnParams().\n"
-            "Expected at least " +
-            std::to_string(paramIndex + 1) +
-            ", but got " + std::to_string(ssGetNumSFcnParams(S));
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
+        SetErrorStatusf(S, "Insufficient number of parameters set via ssSetNumSFcnParams().\nExpected at least %d, but got %d", paramIndex + 1, ssGetNumSFcnParams(S));
         return std::nullopt;
     }
     const mxArray *param = ssGetSFcnParam(S, paramIndex);
     if (param == nullptr)
     {
-        errorMessageParameters = "Parameter at index " + std::to_string(paramIndex) + " is null (not set?)";
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
+        SetErrorStatusf(S, "Parameter at index %d is null (not set?)", paramIndex);
         return std::nullopt;
     }
     if (!mxIsCell(param))
     {
-        errorMessageParameters = "Parameter at index " + std::to_string(paramIndex) + " is not a cell array but " + mxGetClassName(param);
-        ssSetErrorStatus(S, errorMessageParameters.c_str());
+        SetErrorStatusf(S, "Parameter at index %d is not a cell array but %s", paramIndex, mxGetClassName(param));
         return std::nullopt;
     }
     
@@ -342,8 +415,7 @@ std::optional<std::vector<std::vector<std::string>>> extractSFunctionMaskTable(S
             // fprintf(stderr, "Reading cell (%d, %d): Type %s\n", (int)i, (int)j, mxGetClassName(cellElement));
             if (cellElement == nullptr || (!mxIsChar(cellElement) && !mxIsDouble(cellElement)))
             {
-                errorMessageParameters = "Cell element " + std::to_string(i) + " in parameter at index " + std::to_string(paramIndex) + " is not a string";
-                ssSetErrorStatus(S, errorMessageParameters.c_str());
+                SetErrorStatusf(S, "Cell element %zu in parameter at index %d is not a string", (size_t)i, paramIndex);
                 return std::nullopt;
             }
 
@@ -362,8 +434,7 @@ std::optional<std::vector<std::vector<std::string>>> extractSFunctionMaskTable(S
             }
             if (nameBuffer == nullptr)
             {
-                errorMessageParameters = "Failed to convert cell element " + std::to_string(i) + " to string in parameter at index " + std::to_string(paramIndex);
-                ssSetErrorStatus(S, errorMessageParameters.c_str());
+                SetErrorStatusf(S, "Failed to convert cell element %zu to string in parameter at index %d", (size_t)i, paramIndex);
                 return std::nullopt;
             }
             row.emplace_back(nameBuffer);
@@ -0,0 +1,262 @@
+#pragma once
+
+#include "IO.hpp"
+#include "PortTable.hpp"
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+
+namespace port_binding_detail
+{
+    enum class FieldKind
+    {
+        Value,   // scalar member, copied
+        Array,   // std::array<T, N> or T[N] member, copied
+        Pointer, // T * member, pointed at the port buffer
+        View     // PortView / FixedPortView member, pointed at the port buffer
+    };
+
+    template <typename M>
+    struct FieldShape
+    {
+        static constexpr FieldKind kind = FieldKind::Value;
+        using element = M;
+        static constexpr size_t width = 1;
+        static constexpr bool isConst = false;
+    };
+    template <typename T, size_t N>
+    struct FieldShape<std::array<T, N>>
+    {
+        static constexpr FieldKind kind = FieldKind::Array;
+        using element = T;
+        static constexpr size_t width = N;
+        static constexpr bool isConst = false;
+    };
+    template <typename T, size_t N>
+    struct FieldShape<T[N]>
+    {
+        static constexpr FieldKind kind = FieldKind::Array;
+        using element = T;
+        static constexpr size_t width = N;
+        static constexpr bool isConst = false;
+    };
+    // Width 0: given as template argument of the field
+    template <typename T>
+    struct FieldShape<T *>
+    {
+        static constexpr FieldKind kind = FieldKind::Pointer;
+        using element = std::remove_const_t<T>;
+        static constexpr size_t width = 0;
+        static constexpr bool isConst = std::is_const_v<T>;
+    };
+    template <typename T>
+    struct FieldShape<PortView<T>>
+    {
+        static constexpr FieldKind kind = FieldKind::View;
+        using element = std::remove_const_t<T>;
+        static constexpr size_t width = 0;
+        static constexpr bool isConst = std::is_const_v<T>;
+    };
+    template <typename T, size_t Rows, size_t Cols>
+    struct FieldShape<FixedPortView<T, Rows, Cols>>
+    {
+        static constexpr FieldKind kind = FieldKind::View;
+        using element = std::remove_const_t<T>;
+        static constexpr size_t width = Rows * Cols;
+        static constexpr bool isConst = std::is_const_v<T>;
+    };
+
+    template <typename M>
+    struct MemberOf;
+    template <typename S, typename M>
+    struct MemberOf<M S::*>
+    {
+        using Struct = S;
+        using type = M;
+    };
+
+    /**
+     * Binding of one struct member to one port, see InputField / OutputField.
+     */
+    template <auto Member, int Port, size_t Width, bool IsInput>
+    struct PortField
+    {
+        using Struct = typename MemberOf<decltype(Member)>::Struct;
+        using MemberType = typename MemberOf<decltype(Member)>::type;
+        using Shape = FieldShape<MemberType>;
+        using Element = typename Shape::element;
+
+        static constexpr int port = Port;
+        static constexpr size_t width = Width ? Width : Shape::width;
+        static constexpr bool copied = Shape::kind == FieldKind::Value || Shape::kind == FieldKind::Array;
+
+        static_assert(Port >= 0, "Port index must not be negative");
+        static_assert(std::is_arithmetic_v<Element>, "Bound fields must be numeric values, arrays, pointers or port views");
+        static_assert(width > 0, "Pointer and PortView fields need the port width as template argument");
+        static_assert(Width == 0 || Shape::width == 0 || Width == Shape::width, "Port width does not match the size of the field");
+        static_assert(!IsInput || copied || Shape::isConst, "Input pointers and views must point to const");
+
+        /** Check port count, width, data type and buffer of the bound port. */
+        static bool Validate(SimStruct *S)
+        {
+            const char *kind = IsInput ? "Input" : "Output";
+            const int numPorts = IsInput ? ssGetNumInputPorts(S) : ssGetNumOutputPorts(S);
+            if (Port >= numPorts)
+            {
+                SetErrorStatusf(S, "Insufficient number of %s ports configured for Port %d", kind, Port);
+                return false;
+            }
+            const size_t portWidth = IsInput ? ssGetInputPortWidth(S, Port) : ssGetOutputPortWidth(S, Port);
+            if (portWidth != width)
+            {
+                SetErrorStatusf(S, "%s port width %zu does not match expected width %zu for Port %d", kind, portWidth, width, Port);
+                return false;
+            }
+            const DTypeId dataType = IsInput ? ssGetInputPortDataType(S, Port) : ssGetOutputPortDataType(S, Port);
+            if (dataType != SimulinkDataTypeId<Element>())
+            {
+                SetErrorStatusf(S, "%s port data type %d does not match expected data type %d for Port %d", kind, (int)dataType, (int)SimulinkDataTypeId<Element>(), Port);
+                return false;
+            }
+            if (IsInput && !ssGetInputPortRequiredContiguous(S, Port))
+            {
+                SetErrorStatusf(S, "%s port %d is not contiguous, check ssSetInputPortRequiredContiguous()", kind, Port);
+                return false;
+            }
+            if (!Signal(S))
+            {
+                SetErrorStatusf(S, "Failed to get %s port signal for port index %d", kind, Port);
+                return false;
+            }
+            return true;
+        }
+
+        // Inputs: copy or map. Outputs: map pointers and views.
+        static void Gather(SimStruct *S, Struct &values)
+        {
+            if constexpr (IsInput || !copied)
+            {
+                auto *signal = Signal(S);
+                MemberType &field = values.*Member;
+                if constexpr (Shape::kind == FieldKind::Value)
+                    field = *signal;
+                else if constexpr (Shape::kind == FieldKind::Array)
+                    std::copy(signal, signal + width, std::begin(field));
+                else if constexpr (Shape::kind == FieldKind::Pointer)
+                    field = signal;
+                else if constexpr (Shape::width == 0)
+                    field = MemberType(signal, width);
+                else
+                    field = MemberType(signal);
+            }
+        }
+
+        // Outputs: copy values and arrays
+        static void Scatter(SimStruct *S, const Struct &values)
+        {
+            if constexpr (!IsInput && copied)
+            {
+                Element *signal = Signal(S);
+                const MemberType &field = values.*Member;
+                if constexpr (Shape::kind == FieldKind::Value)
+                    *signal = field;
+                else
+                    std::copy(std::begin(field), std::end(field), signal);
+            }
+        }
+
+    private:
+        static auto Signal(SimStruct *S)
+        {
+            if constexpr (IsInput)
+                return static_cast<const Element *>(ssGetInputPortSignal(S, Port));
+            else
+                return static_cast<Element *>(ssGetOutputPortSignal(S, Port));
+        }
+    };
+}
+
+/**
+ * Binds struct member Member to input port Port.
+ *
+ * Scalar, std::array and C array members are copied from the port,
+ * const T * and InputPortView / FixedPortView<const T, ...> members are
+ * pointed at the port buffer without copying. Width is only required for
+ * pointer and PortView members; otherwise it is taken from the member type.
+ */
+template <auto Member, int Port, size_t Width = 0>
+using InputField = port_binding_detail::PortField<Member, Port, Width, true>;
+
+/**
+ * Binds struct member Member to output port Port.
+ *
+ * T * and OutputPortView / FixedPortView members are pointed at the port
+ * buffer by Gather(), so results are written in place. Scalar and array
+ * members are copied to the port by Scatter().
+ */
+template <auto Member, int Port, size_t Width = 0>
+using OutputField = port_binding_detail::PortField<Member, Port, Width, false>;
+
+/**
+ * Moves all port signals of a block into or out of one plain struct:
+ *
+ *   struct Signals
+ *   {
+ *       real_T gain;                         // input 0
+ *       const real_T *samples;               // input 1, 256 elements, not copied
+ *       std::array<real_T, 3> offset;        // input 2
+ *       FixedPortView<real_T, 256> filtered; // output 0, written in place
+ *       real_T energy;                       // output 1
+ *   };
+ *
+ *   using SignalPorts = PortBinding<
+ *       InputField<&Signals::gain, 0>,
+ *       InputField<&Signals::samples, 1, 256>,
+ *       InputField<&Signals::offset, 2>,
+ *       OutputField<&Signals::filtered, 0>,
+ *       OutputField<&Signals::energy, 1>>;
+ *
+ * Call SignalPorts::Validate(S) once in mdlStart. In mdlOutputs,
+ * SignalPorts::Gather(S, signals) fills the struct and SignalPorts::Scatter(S, signals)
+ * writes the copied outputs. Like PortTable, Gather() and Scatter() only
+ * re-validate when SFU_PORT_TABLE_CHECKED is enabled.
+ */
+template <typename... Fields>
+struct PortBinding
+{
+    static_assert(sizeof...(Fields) > 0, "PortBinding needs at least one field");
+
+    using Struct = typename std::tuple_element_t<0, std::tuple<Fields...>>::Struct;
+    static_assert((std::is_same_v<typename Fields::Struct, Struct> && ...),
+                  "All fields of a PortBinding must belong to the same struct");
+
+    /** Validate all bound ports. Call once in mdlStart. */
+    static bool Validate(SimStruct *S)
+    {
+        return (Fields::Validate(S) && ...);
+    }
+
+    /** Copy inputs into values and point its pointer/view members at the ports. */
+    static bool Gather(SimStruct *S, Struct &values)
+    {
+#if SFU_PORT_TABLE_CHECKED
+        if (!Validate(S))
+            return false;
+#endif
+        (Fields::Gather(S, values), ...);
+        return true;
+    }
+
+    /** Copy the scalar and array output members of values to their ports. */
+    static bool Scatter(SimStruct *S, const Struct &values)
+    {
+#if SFU_PORT_TABLE_CHECKED
+        if (!Validate(S))
+            return false;
+#endif
+        (Fields::Scatter(S, values), ...);
+        return true;
+    }
+};
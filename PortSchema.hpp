@@ -0,0 +1,198 @@
+#pragma once
+
+#include "IO.hpp"
+#include "PortTable.hpp"
+#include <utility>
+
+/**
+ * Input port declaration for Ports<...>: Rows x Cols elements of type T.
+ */
+template <typename T, int Rows, int Cols = 1, int DirectFeedthrough = 0>
+struct In
+{
+    static_assert(Rows > 0 && Cols > 0, "Port dimensions must be positive");
+
+    using type = T;
+    using view = FixedPortView<const T, Rows, Cols>;
+    static constexpr int rows = Rows;
+    static constexpr int cols = Cols;
+    static constexpr size_t width = size_t(Rows) * size_t(Cols);
+    static constexpr int directFeedthrough = DirectFeedthrough;
+};
+
+/**
+ * Output port declaration for Ports<...>: Rows x Cols elements of type T.
+ */
+template <typename T, int Rows, int Cols = 1>
+struct Out
+{
+    static_assert(Rows > 0 && Cols > 0, "Port dimensions must be positive");
+
+    using type = T;
+    using view = FixedPortView<T, Rows, Cols>;
+    static constexpr int rows = Rows;
+    static constexpr int cols = Cols;
+    static constexpr size_t width = size_t(Rows) * size_t(Cols);
+};
+
+namespace port_schema_detail
+{
+    template <typename P>
+    struct IsInput : std::false_type
+    {
+    };
+    template <typename T, int Rows, int Cols, int DirectFeedthrough>
+    struct IsInput<In<T, Rows, Cols, DirectFeedthrough>> : std::true_type
+    {
+    };
+
+    template <typename P>
+    struct IsOutput : std::false_type
+    {
+    };
+    template <typename T, int Rows, int Cols>
+    struct IsOutput<Out<T, Rows, Cols>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    struct TypeIdentity
+    {
+        using type = T;
+    };
+
+    // N-th type in P... for which Pred<>::value is true
+    template <template <typename> class Pred, size_t N, typename... P>
+    struct NthMatching
+    {
+    };
+    template <template <typename> class Pred, size_t N, typename First, typename... Rest>
+    struct NthMatching<Pred, N, First, Rest...>
+        : std::conditional_t<Pred<First>::value,
+                             std::conditional_t<N == 0, TypeIdentity<First>, NthMatching<Pred, N - 1, Rest...>>,
+                             NthMatching<Pred, N, Rest...>>
+    {
+    };
+}
+
+/**
+ * Compile-time port schema.
+ *
+ *   using MyPorts = Ports<In<real_T, 3, 3>, In<real_T, 3>, Out<uint8_T, 640, 480>>;
+ *
+ * Inputs and outputs are numbered separately in declaration order.
+ * MyPorts::Define(S) emits all port definitions in mdlInitializeSizes, and the
+ * accessors return FixedPortView objects whose dimensions are the ones
+ * declared here, so sizes cannot drift between definition and use.
+ */
+template <typename... P>
+struct Ports
+{
+    static_assert(((port_schema_detail::IsInput<P>::value || port_schema_detail::IsOutput<P>::value) && ...),
+                  "Ports<...> only accepts In<...> and Out<...> declarations");
+
+    static constexpr int NumInputs = (0 + ... + int(port_schema_detail::IsInput<P>::value));
+    static constexpr int NumOutputs = (0 + ... + int(port_schema_detail::IsOutput<P>::value));
+
+    template <int I>
+    using InputPort = typename port_schema_detail::NthMatching<port_schema_detail::IsInput, I, P...>::type;
+
+    template <int I>
+    using OutputPort = typename port_schema_detail::NthMatching<port_schema_detail::IsOutput, I, P...>::type;
+
+    /**
+     * Set the number of ports and define all of them.
+     * Call in mdlInitializeSizes. Returns false if Simulink rejected a port.
+     */
+    static bool Define(SimStruct *S)
+    {
+        if (!ssSetNumInputPorts(S, NumInputs) || !ssSetNumOutputPorts(S, NumOutputs))
+            return false;
+
+        DefineInputs(S, std::make_index_sequence<NumInputs>{});
+        DefineOutputs(S, std::make_index_sequence<NumOutputs>{});
+        return ssGetErrorStatus(S) == nullptr;
+    }
+
+    /**
+     * Validate all ports of a bound PortTable against the schema.
+     * Call once in mdlStart, after PortTable::Bind().
+     */
+    static bool Validate(PortTable &table)
+    {
+        return ValidateInputs(table, std::make_index_sequence<NumInputs>{}) &&
+               ValidateOutputs(table, std::make_index_sequence<NumOutputs>{});
+    }
+
+    // Unchecked access through a PortTable validated with Validate()
+    template <int I>
+    static typename InputPort<I>::view Input(const PortTable &table)
+    {
+        static_assert(I >= 0 && I < NumInputs, "Input port index out of range");
+        return typename InputPort<I>::view(table.Input<typename InputPort<I>::type>(I));
+    }
+
+    template <int I>
+    static typename OutputPort<I>::view Output(const PortTable &table)
+    {
+        static_assert(I >= 0 && I < NumOutputs, "Output port index out of range");
+        return typename OutputPort<I>::view(table.Output<typename OutputPort<I>::type>(I));
+    }
+
+    // Checked access, same checks as GetInputPortSignal() / GetOutputPortSignal()
+    template <int I>
+    static std::optional<typename InputPort<I>::view> GetInput(SimStruct *S)
+    {
+        static_assert(I >= 0 && I < NumInputs, "Input port index out of range");
+        using Port = InputPort<I>;
+        const typename Port::type *inputSignal = GetInputPortSignal<typename Port::type>(S, I, Port::width);
+        if (!inputSignal)
+            return std::nullopt;
+
+        return typename Port::view(inputSignal);
+    }
+
+    template <int I>
+    static std::optional<typename OutputPort<I>::view> GetOutput(SimStruct *S)
+    {
+        static_assert(I >= 0 && I < NumOutputs, "Output port index out of range");
+        using Port = OutputPort<I>;
+        typename Port::type *outputSignal = GetOutputPortSignal<typename Port::type>(S, I, Port::width);
+        if (!outputSignal)
+            return std::nullopt;
+
+        return typename Port::view(outputSignal);
+    }
+
+    // Only compiles if the array matches the declared port type and size
+    template <int I>
+    static void SetOutput(SimStruct *S, const std::array<typename OutputPort<I>::type, OutputPort<I>::width> &values)
+    {
+        SetVectorOutputPort(S, I, values);
+    }
+
+private:
+    template <size_t... I>
+    static void DefineInputs(SimStruct *S, std::index_sequence<I...>)
+    {
+        (DefineInputPort<typename InputPort<I>::type>(S, I, InputPort<I>::rows, InputPort<I>::cols, InputPort<I>::directFeedthrough), ...);
+    }
+
+    template <size_t... I>
+    static void DefineOutputs(SimStruct *S, std::index_sequence<I...>)
+    {
+        (DefineOutputPort<typename OutputPort<I>::type>(S, I, OutputPort<I>::rows, OutputPort<I>::cols), ...);
+    }
+
+    template <size_t... I>
+    static bool ValidateInputs(PortTable &table, std::index_sequence<I...>)
+    {
+        return (table.ExpectInput<typename InputPort<I>::type>(I, InputPort<I>::width) && ...);
+    }
+
+    template <size_t... I>
+    static bool ValidateOutputs(PortTable &table, std::index_sequence<I...>)
+    {
+        return (table.ExpectOutput<typename OutputPort<I>::type>(I, OutputPort<I>::width) && ...);
+    }
+};
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "IO.hpp"
+#include <vector>
+
+/**
+ * When enabled, PortTable accessors re-validate the port index, data type
+ * and signal pointer on every call, like GetInputPortSignal() does.
+ * Defaults to enabled in debug builds and disabled when NDEBUG is defined.
+ */
+#ifndef SFU_PORT_TABLE_CHECKED
+#ifdef NDEBUG
+#define SFU_PORT_TABLE_CHECKED 0
+#else
+#define SFU_PORT_TABLE_CHECKED 1
+#endif
+#endif
+
+/**
+ * Per-block cache of port signal pointers, widths and data types.
+ *
+ * Port widths and buffers are fixed once the simulation has started, so all
+ * validation happens once in mdlStart:
+ *
+ *   ports->Bind(S) && ports->ExpectInput<real_T>(0, 3) && ports->ExpectOutput<uint8_T>(0, 640 * 480)
+ *
+ * mdlOutputs then uses Input<T>() / Output<T>(), which in release builds
+ * are a plain indexed load without any checks or branches.
+ *
+ * Only input ports declared with ssSetInputPortRequiredContiguous()
+ * (as DefineInputPort() does) can be cached.
+ */
+class PortTable
+{
+public:
+    /**
+     * Cache the signal pointer, width and data type of every port.
+     * Call in mdlStart (or later), when Simulink has allocated the port buffers.
+     * Ports are validated individually through ExpectInput() / ExpectOutput().
+     */
+    bool Bind(SimStruct *S)
+    {
+        S_ = S;
+        inputs_.assign(ssGetNumInputPorts(S), Entry());
+        outputs_.assign(ssGetNumOutputPorts(S), Entry());
+
+        for (int i = 0; i < (int)inputs_.size(); ++i)
+        {
+            Entry &entry = inputs_[i];
+            entry.width = ssGetInputPortWidth(S, i);
+            entry.dataType = ssGetInputPortDataType(S, i);
+            entry.contiguous = ssGetInputPortRequiredContiguous(S, i) != 0;
+            // Non-contiguous ports only provide ssGetInputPortSignalPtrs()
+            if (entry.contiguous)
+                entry.signal = const_cast<void *>(ssGetInputPortSignal(S, i));
+        }
+        for (int i = 0; i < (int)outputs_.size(); ++i)
+        {
+            Entry &entry = outputs_[i];
+            entry.width = ssGetOutputPortWidth(S, i);
+            entry.dataType = ssGetOutputPortDataType(S, i);
+            entry.contiguous = true;
+            entry.signal = ssGetOutputPortSignal(S, i);
+        }
+        return true;
+    }
+
+    /**
+     * Validate that input port portIndex has data type T, the given width
+     * and a contiguous, non-null buffer. Sets the error status on failure.
+     */
+    template <typename T>
+    bool ExpectInput(int portIndex, size_t width)
+    {
+        return Expect<T>(inputs_, "Input", portIndex, width);
+    }
+
+    /**
+     * Validate that output port portIndex has data type T, the given width
+     * and a non-null buffer. Sets the error status on failure.
+     */
+    template <typename T>
+    bool ExpectOutput(int portIndex, size_t width)
+    {
+        return Expect<T>(outputs_, "Output", portIndex, width);
+    }
+
+    template <typename T>
+    const T *Input(int portIndex) const
+    {
+#if SFU_PORT_TABLE_CHECKED
+        if (!Check<T>(inputs_, "Input", portIndex))
+            return nullptr;
+#endif
+        return static_cast<const T *>(inputs_[portIndex].signal);
+    }
+
+    template <typename T>
+    T *Output(int portIndex) const
+    {
+#if SFU_PORT_TABLE_CHECKED
+        if (!Check<T>(outputs_, "Output", portIndex))
+            return nullptr;
+#endif
+        return static_cast<T *>(outputs_[portIndex].signal);
+    }
+
+    template <typename T>
+    InputPortView<T> InputView(int portIndex) const
+    {
+        return InputPortView<T>(Input<T>(portIndex), inputs_[portIndex].width);
+    }
+
+    template <typename T>
+    OutputPortView<T> OutputView(int portIndex) const
+    {
+        return OutputPortView<T>(Output<T>(portIndex), outputs_[portIndex].width);
+    }
+
+    size_t InputWidth(int portIndex) const { return inputs_[portIndex].width; }
+    size_t OutputWidth(int portIndex) const { return outputs_[portIndex].width; }
+    int NumInputs() const { return (int)inputs_.size(); }
+    int NumOutputs() const { return (int)outputs_.size(); }
+
+private:
+    struct Entry
+    {
+        void *signal = nullptr;
+        size_t width = 0;
+        DTypeId dataType = SS_DOUBLE;
+        bool contiguous = false;
+    };
+
+    template <typename T>
+    bool Expect(const std::vector<Entry> &entries, const char *kind, int portIndex, size_t width)
+    {
+        if (portIndex < 0 || portIndex >= (int)entries.size())
+        {
+            SetErrorStatusf(S_, "Insufficient number of %s ports configured for Port %d", kind, portIndex);
+            return false;
+        }
+        const Entry &entry = entries[portIndex];
+        if (entry.width != width)
+        {
+            SetErrorStatusf(S_, "%s port width %zu does not match expected width %zu for Port %d", kind, entry.width, width, portIndex);
+            return false;
+        }
+        if (entry.dataType != SimulinkDataTypeId<T>())
+        {
+            SetErrorStatusf(S_, "%s port data type %d does not match expected data type %d for Port %d", kind, entry.dataType, SimulinkDataTypeId<T>(), portIndex);
+            return false;
+        }
+        if (!entry.contiguous)
+        {
+            SetErrorStatusf(S_, "%s port %d is not contiguous, check ssSetInputPortRequiredContiguous()", kind, portIndex);
+            return false;
+        }
+        if (!entry.signal)
+        {
+            SetErrorStatusf(S_, "Failed to get %s port signal for port index %d", kind, portIndex);
+            return false;
+        }
+        return true;
+    }
+
+#if SFU_PORT_TABLE_CHECKED
+    template <typename T>
+    bool Check(const std::vector<Entry> &entries, const char *kind, int portIndex) const
+    {
+        if (portIndex < 0 || portIndex >= (int)entries.size())
+        {
+            SetErrorStatusf(S_, "%s port %d is not part of the PortTable, call Bind() in mdlStart", kind, portIndex);
+            return false;
+        }
+        const Entry &entry = entries[portIndex];
+        if (entry.dataType != SimulinkDataTypeId<T>() || !entry.contiguous || !entry.signal)
+        {
+            SetErrorStatusf(S_, "%s port %d was accessed with a type or layout it was not validated for", kind, portIndex);
+            return false;
+        }
+        const void *currentSignal = (&entries == &inputs_) ? ssGetInputPortSignal(S_, portIndex) : ssGetOutputPortSignal(S_, portIndex);
+        if (entry.signal != currentSignal)
+        {
+            SetErrorStatusf(S_, "%s port %d signal buffer moved since PortTable::Bind()", kind, portIndex);
+            return false;
+        }
+        return true;
+    }
+#endif
+
+    SimStruct *S_ = nullptr;
+    std::vector<Entry> inputs_;
+    std::vector<Entry> outputs_;
+};
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * Binary signal log format, written by SignalLogger and read by SignalLogReader.
+ *
+ *   SignalLogHeader
+ *   SignalLogChannel[channelCount]
+ *   padding up to headerSize (a multiple of 64)
+ *   recordCount records of recordSize bytes:
+ *     double time, then each channel's raw port buffer at its offset
+ *
+ * All values are in the byte order of the writing machine; byteOrder tells
+ * a reader whether that matches its own. Channel data is 8-byte aligned
+ * within a record, and records are 8-byte aligned within the file.
+ */
+namespace signal_log
+{
+    constexpr char Magic[8] = {'S', 'F', 'U', 'S', 'L', 'O', 'G', '\0'};
+    constexpr uint32_t Version = 1;
+    constexpr uint32_t ByteOrderMark = 0x01020304;
+    constexpr size_t NameLength = 40;
+    constexpr size_t SourceLength = 128;
+
+    enum Direction : int32_t
+    {
+        Input = 0,
+        Output = 1
+    };
+
+    constexpr size_t AlignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+struct SignalLogHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t headerSize;
+    uint32_t channelCount;
+    uint32_t recordSize;
+    uint32_t reserved;
+    uint64_t recordCount; // records written so far, updated while logging
+    uint64_t dropped;     // records lost because the buffer or the file was full
+    char source[signal_log::SourceLength]; // path of the logging block
+};
+
+struct SignalLogChannel
+{
+    char name[signal_log::NameLength];
+    int32_t port;
+    int32_t direction; // signal_log::Direction
+    int32_t dataType;  // Simulink DTypeId
+    uint32_t elementSize; // twice the data type size for complex signals
+    uint32_t width;
+    uint32_t rows;
+    uint32_t cols;
+    uint32_t offset; // byte offset of the channel within a record
+};
+
+static_assert(std::is_trivially_copyable_v<SignalLogHeader> && sizeof(SignalLogHeader) % 8 == 0, "SignalLogHeader layout");
+static_assert(std::is_trivially_copyable_v<SignalLogChannel> && sizeof(SignalLogChannel) % 8 == 0, "SignalLogChannel layout");
+
+/**
+ * Reads a signal log file without copying it: the file is mapped and all
+ * accessors return pointers into the mapping.
+ *
+ *   SignalLogReader log;
+ *   if (!log.Open("run.sfulog"))
+ *       fprintf(stderr, "%s\n", log.error());
+ *   int speed = log.FindChannel("speed");
+ *   for (size_t i = 0; i < log.recordCount(); ++i)
+ *       printf("%g %g\n", log.Time(i), log.Samples<real_T>(i, speed)[0]);
+ *
+ * Does not depend on simstruc.h, so it can be used in offline tools.
+ */
+class SignalLogReader
+{
+public:
+    bool Open(const char *path)
+    {
+        Close();
+        if (!file_.Open(path))
+            return Fail("Cannot open signal log file");
+        if (file_.size() < sizeof(SignalLogHeader))
+            return Fail("File is too small to be a signal log");
+
+        header_ = static_cast<const SignalLogHeader *>(file_.data());
+        if (std::memcmp(header_->magic, signal_log::Magic, sizeof(signal_log::Magic)) != 0)
+            return Fail("Not a signal log file");
+        if (header_->version != signal_log::Version)
+            return Fail("Unsupported signal log version");
+        if (header_->byteOrder != signal_log::ByteOrderMark)
+            return Fail("Signal log was written with a different byte order");
+        if (header_->headerSize < sizeof(SignalLogHeader) + header_->channelCount * sizeof(SignalLogChannel) ||
+            header_->headerSize > file_.size() || header_->recordSize < sizeof(double))
+            return Fail("Corrupt signal log header");
+
+        channels_ = reinterpret_cast<const SignalLogChannel *>(header_ + 1);
+        for (size_t c = 0; c < channelCount(); ++c)
+        {
+            if (channels_[c].offset + size_t(channels_[c].width) * channels_[c].elementSize > header_->recordSize)
+                return Fail("Corrupt signal log channel table");
+        }
+        records_ = static_cast<const unsigned char *>(file_.data()) + header_->headerSize;
+
+        // A log that was not closed may claim more records than were flushed to the file
+        const size_t available = (file_.size() - header_->headerSize) / header_->recordSize;
+        recordCount_ = header_->recordCount < available ? size_t(header_->recordCount) : available;
+        return true;
+    }
+
+    void Close()
+    {
+        file_.Close();
+        header_ = nullptr;
+        channels_ = nullptr;
+        records_ = nullptr;
+        recordCount_ = 0;
+        error_ = nullptr;
+    }
+
+    bool IsOpen() const noexcept { return header_ != nullptr; }
+
+    /** Reason the last Open() failed. */
+    const char *error() const noexcept { return error_ ? error_ : ""; }
+
+    const SignalLogHeader &header() const noexcept { return *header_; }
+    size_t channelCount() const noexcept { return header_->channelCount; }
+    size_t recordCount() const noexcept { return recordCount_; }
+    size_t recordSize() const noexcept { return header_->recordSize; }
+    size_t dropped() const noexcept { return size_t(header_->dropped); }
+
+    const SignalLogChannel &Channel(size_t channel) const noexcept { return channels_[channel]; }
+
+    /** Index of the channel called name, or -1. */
+    int FindChannel(const char *name) const noexcept
+    {
+        for (size_t c = 0; c < channelCount(); ++c)
+        {
+            if (std::strncmp(channels_[c].name, name, signal_log::NameLength) == 0)
+                return static_cast<int>(c);
+        }
+        return -1;
+    }
+
+    /** Raw bytes of record index, starting with its time stamp. */
+    const void *Record(size_t index) const noexcept { return records_ + index * header_->recordSize; }
+
+    double Time(size_t index) const noexcept
+    {
+        double time;
+        std::memcpy(&time, Record(index), sizeof(time));
+        return time;
+    }
+
+    /** Raw bytes of one channel in record index. */
+    const void *Data(size_t index, size_t channel) const noexcept
+    {
+        return records_ + index * header_->recordSize + channels_[channel].offset;
+    }
+
+    /** Samples of one channel in record index, or nullptr if T does not have the channel's element size. */
+    template <typename T>
+    const T *Samples(size_t index, size_t channel) const noexcept
+    {
+        if (sizeof(T) != channels_[channel].elementSize)
+            return nullptr;
+        return static_cast<const T *>(Data(index, channel));
+    }
+
+private:
+    bool Fail(const char *message)
+    {
+        file_.Close();
+        header_ = nullptr;
+        error_ = message;
+        return false;
+    }
+
+    MappedFile file_;
+    const SignalLogHeader *header_ = nullptr;
+    const SignalLogChannel *channels_ = nullptr;
+    const unsigned char *records_ = nullptr;
+    size_t recordCount_ = 0;
+    const char *error_ = nullptr;
+};
@@ -0,0 +1,342 @@
+#pragma once
+
+#include "simstruc.h"
+#include "ErrorStatus.hpp"
+#include "MappedFile.hpp"
+#include "SignalLog.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// Interval in which the background thread moves buffered records to the file
+#ifndef SFU_SIGNAL_LOG_DRAIN_INTERVAL_US
+#define SFU_SIGNAL_LOG_DRAIN_INTERVAL_US 1000
+#endif
+
+enum class SignalLogOverflow
+{
+    // Count records that find the ring buffer full as dropped; Log() never waits
+    Drop,
+    // Wait for the background thread to make room; for recordings that must be
+    // complete, e.g. as reference for SignalReplay, when step time does not matter
+    Wait
+};
+
+/**
+ * Logs port buffers with their time stamp to a binary file (see SignalLog.hpp):
+ *
+ *   mdlStart:     logger.AddInputPort(S, 0, "speed");
+ *                 logger.AddOutputPort(S, 0, "torque");
+ *                 logger.Open(S, "run.sfulog", 1000000); // room for 10^6 records
+ *   mdlOutputs:   logger.Log(S);
+ *   mdlTerminate: logger.Close();
+ *
+ * Log() copies the registered port buffers into a preallocated lock-free
+ * ring buffer and returns; it never blocks, allocates or does I/O. A
+ * background thread moves the records into the memory-mapped file, which
+ * is preallocated for maxRecords records by Open() and cut to the records
+ * actually written by Close(). Records that do not fit into the ring
+ * buffer (with SignalLogOverflow::Drop) or the file are counted as
+ * dropped. Keep the logger in the block's state (e.g. a StateArena).
+ */
+class SignalLogger
+{
+public:
+    SignalLogger() = default;
+    SignalLogger(const SignalLogger &) = delete;
+    SignalLogger &operator=(const SignalLogger &) = delete;
+    ~SignalLogger() { Close(); }
+
+    /**
+     * Register input port portIndex. The port must be contiguous. Call after
+     * the port sizes are known (mdlStart) and before Open().
+     */
+    bool AddInputPort(SimStruct *S, int portIndex, const char *name = nullptr)
+    {
+        if (!CanAddChannel(S))
+            return false;
+        if (ssGetNumInputPorts(S) <= portIndex)
+        {
+            SetErrorStatusf(S, "Insufficient number of Input ports configured for Port %d", portIndex);
+            return false;
+        }
+        if (!ssGetInputPortRequiredContiguous(S, portIndex))
+        {
+            SetErrorStatusf(S, "Input port %d is not contiguous, check ssSetInputPortRequiredContiguous()", portIndex);
+            return false;
+        }
+        return AddChannel(S, portIndex, signal_log::Input, ssGetInputPortDataType(S, portIndex), ssGetInputPortWidth(S, portIndex),
+                          ssGetInputPortNumDimensions(S, portIndex), ssGetInputPortDimensions(S, portIndex),
+                          ssGetInputPortComplexSignal(S, portIndex) == COMPLEX_YES, name);
+    }
+
+    /** Register output port portIndex, see AddInputPort(). */
+    bool AddOutputPort(SimStruct *S, int portIndex, const char *name = nullptr)
+    {
+        if (!CanAddChannel(S))
+            return false;
+        if (ssGetNumOutputPorts(S) <= portIndex)
+        {
+            SetErrorStatusf(S, "Insufficient number of Output ports configured for Port %d", portIndex);
+            return false;
+        }
+        return AddChannel(S, portIndex, signal_log::Output, ssGetOutputPortDataType(S, portIndex), ssGetOutputPortWidth(S, portIndex),
+                          ssGetOutputPortNumDimensions(S, portIndex), ssGetOutputPortDimensions(S, portIndex),
+                          ssGetOutputPortComplexSignal(S, portIndex) == COMPLEX_YES, name);
+    }
+
+    /**
+     * Create path with room for maxRecords records and start the background
+     * thread. bufferRecords is the number of records Log() can get ahead of it.
+     */
+    bool Open(SimStruct *S, const char *path, size_t maxRecords, size_t bufferRecords = 4096,
+              SignalLogOverflow overflow = SignalLogOverflow::Drop)
+    {
+        if (IsOpen())
+        {
+            SetErrorStatusf(S, "Signal log %s is already open", path);
+            return false;
+        }
+        if (channels_.empty() || maxRecords == 0 || bufferRecords == 0)
+        {
+            SetErrorStatusf(S, "Signal log %s needs at least one channel and a record capacity", path);
+            return false;
+        }
+
+        const size_t headerSize = signal_log::AlignUp(sizeof(SignalLogHeader) + channels_.size() * sizeof(SignalLogChannel), 64);
+        // Drain() relies on maxRecords records fitting into the mapping
+        if (maxRecords > (SIZE_MAX - headerSize) / recordSize_)
+        {
+            SetErrorStatusf(S, "Signal log %s cannot hold %zu records of %zu bytes", path, maxRecords, recordSize_);
+            return false;
+        }
+        if (!file_.Create(path, headerSize + maxRecords * recordSize_))
+        {
+            SetErrorStatusf(S, "Failed to create signal log file %s", path);
+            return false;
+        }
+
+        SignalLogHeader header{};
+        std::memcpy(header.magic, signal_log::Magic, sizeof(header.magic));
+        header.version = signal_log::Version;
+        header.byteOrder = signal_log::ByteOrderMark;
+        header.headerSize = static_cast<uint32_t>(headerSize);
+        header.channelCount = static_cast<uint32_t>(channels_.size());
+        header.recordSize = static_cast<uint32_t>(recordSize_);
+        std::snprintf(header.source, sizeof(header.source), "%s", ssGetPath(S));
+        unsigned char *base = static_cast<unsigned char *>(file_.data());
+        std::memcpy(base, &header, sizeof(header));
+        std::memcpy(base + sizeof(header), channels_.data(), channels_.size() * sizeof(SignalLogChannel));
+        header_ = reinterpret_cast<SignalLogHeader *>(base);
+        records_ = base + headerSize;
+        maxRecords_ = maxRecords;
+        written_ = 0;
+        overflow_ = overflow;
+
+        size_t slots = 1;
+        while (slots < bufferRecords)
+            slots *= 2;
+        buffer_.assign(slots * recordSize_ / sizeof(uint64_t), 0);
+        slotMask_ = slots - 1;
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+        cachedHead_ = 0;
+        dropped_.store(0, std::memory_order_relaxed);
+        stop_.store(false, std::memory_order_relaxed);
+
+        try
+        {
+            drainThread_ = std::thread([this] { DrainLoop(); });
+        }
+        catch (const std::system_error &)
+        {
+            file_.Close();
+            header_ = nullptr;
+            SetErrorStatusf(S, "Failed to start the signal log thread for %s", path);
+            return false;
+        }
+        return true;
+    }
+
+    bool IsOpen() const noexcept { return header_ != nullptr; }
+
+    /** Record the registered ports at the current time. Call in mdlOutputs. */
+    void Log(SimStruct *S)
+    {
+        if (!IsOpen())
+            return;
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ > slotMask_)
+        {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ > slotMask_ && !WaitForRoom(tail))
+            {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+
+        unsigned char *record = Slot(tail);
+        const time_T time = ssGetT(S);
+        std::memcpy(record, &time, sizeof(double));
+        for (const SignalLogChannel &channel : channels_)
+        {
+            const void *signal = channel.direction == signal_log::Input ? ssGetInputPortSignal(S, channel.port)
+                                                                        : ssGetOutputPortSignal(S, channel.port);
+            std::memcpy(record + channel.offset, signal, size_t(channel.width) * channel.elementSize);
+        }
+        tail_.store(tail + 1, std::memory_order_release);
+    }
+
+    /** Write all buffered records, finalise the header and close the file. Call in mdlTerminate. */
+    void Close()
+    {
+        if (!IsOpen())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(drainMutex_);
+            stop_.store(true, std::memory_order_relaxed);
+        }
+        drainCondition_.notify_one();
+        drainThread_.join();
+
+        header_->recordCount = written_;
+        header_->dropped = dropped_.load(std::memory_order_relaxed);
+        file_.Close(header_->headerSize + written_ * recordSize_);
+        header_ = nullptr;
+        records_ = nullptr;
+    }
+
+    /** Records lost so far because the buffer or the file was full. */
+    size_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    size_t channelCount() const noexcept { return channels_.size(); }
+    size_t recordSize() const noexcept { return recordSize_; }
+
+private:
+    bool CanAddChannel(SimStruct *S)
+    {
+        if (IsOpen())
+        {
+            SetErrorStatusf(S, "Signal log channels must be added before Open()");
+            return false;
+        }
+        return true;
+    }
+
+    bool AddChannel(SimStruct *S, int portIndex, signal_log::Direction direction, DTypeId dataType, int_T width,
+                    int_T numDims, const int_T *dims, bool complex, const char *name)
+    {
+        // Complex elements are stored as interleaved real and imaginary parts
+        const int_T elementSize = ssGetDataTypeSize(S, dataType) * (complex ? 2 : 1);
+        if (elementSize <= 0 || width <= 0)
+        {
+            SetErrorStatusf(S, "Cannot log %s port %d with data type %d and width %d",
+                            direction == signal_log::Input ? "input" : "output", portIndex, (int)dataType, (int)width);
+            return false;
+        }
+
+        SignalLogChannel channel{};
+        if (name)
+            std::snprintf(channel.name, sizeof(channel.name), "%s", name);
+        else
+            std::snprintf(channel.name, sizeof(channel.name), "%s%d", direction == signal_log::Input ? "in" : "out", portIndex);
+        channel.port = portIndex;
+        channel.direction = direction;
+        channel.dataType = dataType;
+        channel.elementSize = static_cast<uint32_t>(elementSize);
+        channel.width = static_cast<uint32_t>(width);
+        channel.rows = static_cast<uint32_t>(numDims >= 1 ? dims[0] : width);
+        channel.cols = static_cast<uint32_t>(numDims >= 2 ? dims[1] : 1);
+        channel.offset = static_cast<uint32_t>(recordSize_);
+        recordSize_ = signal_log::AlignUp(recordSize_ + size_t(width) * elementSize, 8);
+        channels_.push_back(channel);
+        return true;
+    }
+
+    bool WaitForRoom(size_t tail)
+    {
+        if (overflow_ != SignalLogOverflow::Wait)
+            return false;
+        {
+            std::lock_guard<std::mutex> lock(drainMutex_);
+            drainRequested_ = true;
+        }
+        drainCondition_.notify_one();
+        while (tail - cachedHead_ > slotMask_)
+        {
+            std::this_thread::yield();
+            cachedHead_ = head_.load(std::memory_order_acquire);
+        }
+        return true;
+    }
+
+    unsigned char *Slot(size_t index)
+    {
+        return reinterpret_cast<unsigned char *>(buffer_.data()) + (index & slotMask_) * recordSize_;
+    }
+
+    void DrainLoop()
+    {
+        while (true)
+        {
+            const bool stopping = stop_.load(std::memory_order_relaxed);
+            Drain();
+            if (stopping)
+                return;
+            std::unique_lock<std::mutex> lock(drainMutex_);
+            drainCondition_.wait_for(lock, std::chrono::microseconds(SFU_SIGNAL_LOG_DRAIN_INTERVAL_US),
+                                     [&] { return stop_.load(std::memory_order_relaxed) || drainRequested_; });
+            drainRequested_ = false;
+        }
+    }
+
+    // Move all buffered records into the file
+    void Drain()
+    {
+        size_t head = head_.load(std::memory_order_relaxed);
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        for (; head != tail; ++head)
+        {
+            if (written_ < maxRecords_)
+                std::memcpy(records_ + written_++ * recordSize_, Slot(head), recordSize_);
+            else
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+        head_.store(head, std::memory_order_release);
+        header_->recordCount = written_;
+    }
+
+    std::vector<SignalLogChannel> channels_;
+    size_t recordSize_ = sizeof(double); // time stamp
+
+    MappedFile file_;
+    SignalLogHeader *header_ = nullptr;
+    unsigned char *records_ = nullptr;
+    size_t maxRecords_ = 0;
+    size_t written_ = 0; // drain thread only (until Close)
+    SignalLogOverflow overflow_ = SignalLogOverflow::Drop;
+
+    // Ring buffer of records, uint64_t for 8-byte alignment
+    std::vector<uint64_t> buffer_;
+    size_t slotMask_ = 0;
+    size_t cachedHead_ = 0; // Log() only
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+    std::atomic<size_t> dropped_{0};
+
+    std::thread drainThread_;
+    std::atomic<bool> stop_{false};
+    std::mutex drainMutex_;
+    std::condition_variable drainCondition_;
+    bool drainRequested_ = false; // guarded by drainMutex_
+};
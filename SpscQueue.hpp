@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Bounded lock-free queue between exactly one producer thread and one
+ * consumer thread.
+ *
+ * Elements live in preallocated slots and are written and read in place:
+ *
+ *   producer: if (T *slot = queue.Back()) { Fill(*slot); queue.Push(); }
+ *   consumer: if (T *slot = queue.Front()) { Use(*slot); queue.Pop(); }
+ *
+ * Slots are reused, so a producer must overwrite everything it relies on.
+ * Head and tail are on separate cache lines, and each side keeps a cached
+ * copy of the other side's index, so the shared line is only read when the
+ * queue looks full or empty.
+ */
+template <typename T>
+class SpscQueue
+{
+public:
+    SpscQueue() = default;
+    explicit SpscQueue(size_t capacity) { Reserve(capacity); }
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    /**
+     * Allocate at least capacity slots (rounded up to a power of two) and
+     * empty the queue. Not thread-safe; call before producer and consumer start.
+     */
+    void Reserve(size_t capacity)
+    {
+        size_t slots = 1;
+        while (slots < capacity)
+            slots *= 2;
+        slots_.assign(slots, T());
+        mask_ = slots - 1;
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+        cachedHead_ = 0;
+        cachedTail_ = 0;
+    }
+
+    size_t capacity() const noexcept { return slots_.size(); }
+
+    /** Number of queued elements; exact only on the producer or consumer thread. */
+    size_t size() const noexcept
+    {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    // Producer
+
+    /** Free slot to fill, or nullptr if the queue is full. */
+    T *Back() noexcept
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ == slots_.size())
+        {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ == slots_.size())
+                return nullptr;
+        }
+        return &slots_[tail & mask_];
+    }
+
+    /** Publish the slot returned by Back(). */
+    void Push() noexcept { tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    bool TryPush(const T &value)
+    {
+        T *slot = Back();
+        if (!slot)
+            return false;
+        *slot = value;
+        Push();
+        return true;
+    }
+
+    // Consumer
+
+    /** Oldest element, or nullptr if the queue is empty. */
+    T *Front() noexcept
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_)
+        {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_)
+                return nullptr;
+        }
+        return &slots_[head & mask_];
+    }
+
+    /** Release the slot returned by Front() to the producer. */
+    void Pop() noexcept { head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    bool TryPop(T &value)
+    {
+        T *slot = Front();
+        if (!slot)
+            return false;
+        value = *slot;
+        Pop();
+        return true;
+    }
+
+private:
+    std::vector<T> slots_;
+    size_t mask_ = 0;
+
+    // Consumer side
+    alignas(64) std::atomic<size_t> head_{0};
+    size_t cachedTail_ = 0;
+
+    // Producer side
+    alignas(64) std::atomic<size_t> tail_{0};
+    size_t cachedHead_ = 0;
+};
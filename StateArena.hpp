@@ -0,0 +1,294 @@
+#pragma once
+
+#include "simstruc.h"
+#include "ErrorStatus.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <new>
+#include <tuple>
+#include <type_traits>
+
+// Alignment of every state object, to keep states of different instances
+// and frequently written states off shared cache lines
+#ifndef SFU_CACHE_LINE_SIZE
+#define SFU_CACHE_LINE_SIZE 64
+#endif
+
+/**
+ * Array state whose length is only known in mdlStart, e.g. from a parameter.
+ * Its elements are stored in the arena behind the fixed-size states.
+ */
+template <typename T>
+class StateArray
+{
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using iterator = T *;
+
+    T *data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    T *begin() const noexcept { return data_; }
+    T *end() const noexcept { return data_ + size_; }
+
+    T &operator[](size_t index) const noexcept { return data_[index]; }
+
+private:
+    template <int, typename...>
+    friend class StateArenaAt;
+
+    T *data_ = nullptr;
+    size_t size_ = 0;
+};
+
+namespace state_arena_detail
+{
+    template <typename T>
+    struct ArrayElement
+    {
+        static constexpr bool isArray = false;
+        using type = void;
+    };
+    template <typename T>
+    struct ArrayElement<StateArray<T>>
+    {
+        static constexpr bool isArray = true;
+        using type = T;
+    };
+
+    constexpr size_t AlignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    template <typename T>
+    constexpr size_t StateAlignment()
+    {
+        return alignof(T) > SFU_CACHE_LINE_SIZE ? alignof(T) : SFU_CACHE_LINE_SIZE;
+    }
+
+    // Offset of every state in the arena, followed by the end of the last one
+    template <typename... States>
+    constexpr std::array<size_t, sizeof...(States) + 1> StateOffsets()
+    {
+        constexpr size_t count = sizeof...(States);
+        constexpr size_t sizes[] = {sizeof(States)...};
+        constexpr size_t alignments[] = {StateAlignment<States>()...};
+        std::array<size_t, count + 1> offsets{};
+        for (size_t i = 0; i < count; ++i)
+            offsets[i] = AlignUp(i == 0 ? 0 : offsets[i - 1] + sizes[i - 1], alignments[i]);
+        offsets[count] = offsets[count - 1] + sizes[count - 1];
+        return offsets;
+    }
+
+    template <typename T, typename... States>
+    constexpr size_t IndexOf()
+    {
+        constexpr bool matches[] = {std::is_same_v<T, States>...};
+        size_t index = sizeof...(States);
+        for (size_t i = 0; i < sizeof...(States); ++i)
+        {
+            if (matches[i])
+                index = index == sizeof...(States) ? i : sizeof...(States) + 1;
+        }
+        return index;
+    }
+}
+
+/**
+ * Per-instance state of an S-Function, allocated in one block.
+ *
+ *   using State = StateArena<Filter, std::array<real_T, 64>, StateArray<real_T>>;
+ *
+ *   mdlInitializeSizes: State::Declare(S);             // reserves the PWork slot
+ *   mdlStart:           State::Create(S, historyLength); // one length per StateArray
+ *   mdlOutputs:         Filter &filter = State::Get<Filter>(S);
+ *                       StateArray<real_T> &history = State::Get<2>(S);
+ *   mdlTerminate:       State::Destroy(S);
+ *
+ * Every state is default-constructed in a single cache-line-aligned
+ * allocation, starts on its own cache line and is destroyed in reverse
+ * order. The offsets of all states are compile-time constants, so Get()
+ * is one PWork load plus a constant offset. State constructors must not throw.
+ *
+ * The arena pointer lives in PWork slot PWorkIndex; StateArena<...> uses slot 0.
+ */
+template <int PWorkIndex, typename... States>
+class StateArenaAt
+{
+    static_assert(sizeof...(States) > 0, "StateArena needs at least one state type");
+    static_assert((std::is_default_constructible_v<States> && ...), "State types must be default constructible");
+
+    using Tuple = std::tuple<States...>;
+    static constexpr size_t Count = sizeof...(States);
+
+public:
+    static constexpr size_t NumArrays = (0 + ... + size_t(state_arena_detail::ArrayElement<States>::isArray));
+    static constexpr size_t Alignment = std::max({state_arena_detail::StateAlignment<States>()...});
+
+    template <size_t I>
+    using StateType = std::tuple_element_t<I, Tuple>;
+
+    /** Reserve the PWork slot. Call in mdlInitializeSizes. */
+    static void Declare(SimStruct *S)
+    {
+        if (ssGetNumPWork(S) <= PWorkIndex)
+            ssSetNumPWork(S, PWorkIndex + 1);
+    }
+
+    /**
+     * Allocate and construct all states. Call in mdlStart, with one length
+     * per StateArray in declaration order. Returns false and sets the error
+     * status on failure.
+     */
+    template <typename... Lengths>
+    static bool Create(SimStruct *S, Lengths... arrayLengths)
+    {
+        static_assert(sizeof...(Lengths) == NumArrays, "Create() needs one length per StateArray");
+        if (ssGetNumPWork(S) <= PWorkIndex)
+        {
+            SetErrorStatusf(S, "StateArena needs PWork slot %d, call Declare() in mdlInitializeSizes", PWorkIndex);
+            return false;
+        }
+        if (ssGetPWork(S)[PWorkIndex] != nullptr)
+        {
+            SetErrorStatusf(S, "PWork slot %d is already in use, StateArena::Create() called twice?", PWorkIndex);
+            return false;
+        }
+
+        const size_t lengths[NumArrays + 1] = {static_cast<size_t>(arrayLengths)...};
+        const size_t size = TotalSize(lengths, std::make_index_sequence<Count>{});
+        void *memory = ::operator new(size, std::align_val_t(Alignment), std::nothrow);
+        if (!memory)
+        {
+            SetErrorStatusf(S, "Failed to allocate %zu bytes of block state", size);
+            return false;
+        }
+
+        size_t arrayOffset = FixedSize;
+        ConstructAll(static_cast<char *>(memory), lengths, arrayOffset, std::make_index_sequence<Count>{});
+        ssGetPWork(S)[PWorkIndex] = memory;
+        return true;
+    }
+
+    /** Whether Create() succeeded and Destroy() has not been called yet. */
+    static bool Created(SimStruct *S)
+    {
+        return ssGetNumPWork(S) > PWorkIndex && ssGetPWork(S)[PWorkIndex] != nullptr;
+    }
+
+    /** State I; only valid between Create() and Destroy(). */
+    template <size_t I>
+    static StateType<I> &Get(SimStruct *S)
+    {
+        return *At<I>(static_cast<char *>(ssGetPWork(S)[PWorkIndex]));
+    }
+
+    /** The state of type T, if T occurs exactly once in States. */
+    template <typename T>
+    static T &Get(SimStruct *S)
+    {
+        constexpr size_t index = state_arena_detail::IndexOf<T, States...>();
+        static_assert(index < Count, "T is not a state type of this arena, or occurs more than once");
+        return Get<index>(S);
+    }
+
+    /** Destroy all states in reverse order and free the arena. Call in mdlTerminate. */
+    static void Destroy(SimStruct *S)
+    {
+        if (!Created(S))
+            return;
+        char *base = static_cast<char *>(ssGetPWork(S)[PWorkIndex]);
+        DestroyAll(base, std::make_index_sequence<Count>{});
+        ::operator delete(base, std::align_val_t(Alignment));
+        ssGetPWork(S)[PWorkIndex] = nullptr;
+    }
+
+private:
+    static constexpr std::array<size_t, Count + 1> Offsets = state_arena_detail::StateOffsets<States...>();
+    // End of the fixed-size states; StateArray elements follow
+    static constexpr size_t FixedSize = Offsets[Count];
+
+    template <size_t I>
+    static StateType<I> *At(char *base)
+    {
+        return std::launder(reinterpret_cast<StateType<I> *>(base + Offsets[I]));
+    }
+
+    // Index of state I among the StateArray states
+    template <size_t I>
+    static constexpr size_t ArrayIndex()
+    {
+        constexpr bool isArray[] = {state_arena_detail::ArrayElement<States>::isArray...};
+        size_t index = 0;
+        for (size_t i = 0; i < I; ++i)
+            index += isArray[i];
+        return index;
+    }
+
+    template <size_t... I>
+    static size_t TotalSize(const size_t *lengths, std::index_sequence<I...>)
+    {
+        size_t size = FixedSize;
+        (AddArraySize<I>(size, lengths), ...);
+        return state_arena_detail::AlignUp(size, Alignment);
+    }
+
+    template <size_t I>
+    static void AddArraySize(size_t &size, const size_t *lengths)
+    {
+        using Element = typename state_arena_detail::ArrayElement<StateType<I>>::type;
+        if constexpr (!std::is_void_v<Element>)
+            size = state_arena_detail::AlignUp(size, state_arena_detail::StateAlignment<Element>()) + lengths[ArrayIndex<I>()] * sizeof(Element);
+    }
+
+    template <size_t... I>
+    static void ConstructAll(char *base, const size_t *lengths, size_t &arrayOffset, std::index_sequence<I...>)
+    {
+        (Construct<I>(base, lengths, arrayOffset), ...);
+    }
+
+    template <size_t I>
+    static void Construct(char *base, const size_t *lengths, size_t &arrayOffset)
+    {
+        using State = StateType<I>;
+        using Element = typename state_arena_detail::ArrayElement<State>::type;
+        State *state = new (base + Offsets[I]) State();
+        if constexpr (!std::is_void_v<Element>)
+        {
+            arrayOffset = state_arena_detail::AlignUp(arrayOffset, state_arena_detail::StateAlignment<Element>());
+            state->data_ = reinterpret_cast<Element *>(base + arrayOffset);
+            state->size_ = lengths[ArrayIndex<I>()];
+            for (size_t i = 0; i < state->size_; ++i)
+                new (state->data_ + i) Element();
+            arrayOffset += state->size_ * sizeof(Element);
+        }
+    }
+
+    template <size_t... I>
+    static void DestroyAll(char *base, std::index_sequence<I...>)
+    {
+        // Reverse order of construction
+        (DestroyOne<Count - 1 - I>(base), ...);
+    }
+
+    template <size_t I>
+    static void DestroyOne(char *base)
+    {
+        using State = StateType<I>;
+        using Element = typename state_arena_detail::ArrayElement<State>::type;
+        State *state = At<I>(base);
+        if constexpr (!std::is_void_v<Element>)
+        {
+            for (size_t i = state->size_; i > 0; --i)
+                state->data_[i - 1].~Element();
+        }
+        state->~State();
+    }
+};
+
+template <typename... States>
+using StateArena = StateArenaAt<0, States...>;
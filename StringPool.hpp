@@ -0,0 +1,232 @@
+#pragma once
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#include <optional>
+#include "Parameters.hpp"
+
+/**
+ * Handle to a string stored in the process-wide StringPool.
+ *
+ * Equal strings are stored once, so two handles are equal exactly when they
+ * point to the same storage. The characters stay valid (and NUL-terminated)
+ * until the process exits or the MEX file is unloaded.
+ */
+class InternedString
+{
+public:
+    InternedString() = default;
+
+    const char *c_str() const { return data_; }
+    const char *data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    std::string_view view() const { return std::string_view(data_, size_); }
+    operator std::string_view() const { return view(); }
+
+    bool operator==(const InternedString &other) const { return data_ == other.data_ || (size_ == 0 && other.size_ == 0); }
+    bool operator!=(const InternedString &other) const { return !(*this == other); }
+
+private:
+    friend class StringPool;
+    InternedString(const char *data, size_t size) : data_(data), size_(size) {}
+
+    const char *data_ = "";
+    size_t size_ = 0;
+};
+
+/**
+ * Process-wide, thread-safe string interning arena.
+ *
+ * Strings are copied into 64 KiB chunks that are never freed individually,
+ * which keeps the per-string overhead to the hash set entry. Use it for
+ * values repeated across many block instances, e.g. signal names and enum labels.
+ */
+class StringPool
+{
+public:
+    static StringPool &Instance()
+    {
+        static StringPool pool;
+        return pool;
+    }
+
+    InternedString Intern(std::string_view text)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = strings_.find(text);
+        if (it == strings_.end())
+            it = strings_.insert(Store(text)).first;
+        return InternedString(it->data(), it->size());
+    }
+
+    size_t Count() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return strings_.size();
+    }
+
+    // Bytes reserved for string storage
+    size_t Capacity() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return capacity_;
+    }
+
+private:
+    static constexpr size_t ChunkSize = 64 * 1024;
+
+    StringPool() = default;
+    StringPool(const StringPool &) = delete;
+    StringPool &operator=(const StringPool &) = delete;
+
+    std::string_view Store(std::string_view text)
+    {
+        const size_t required = text.size() + 1;
+        if (required > remaining_)
+        {
+            // Oversized strings get a chunk of their own
+            const size_t size = required > ChunkSize ? required : ChunkSize;
+            chunks_.emplace_back(new char[size]);
+            capacity_ += size;
+            cursor_ = chunks_.back().get();
+            remaining_ = size;
+        }
+        char *stored = cursor_;
+        std::memcpy(stored, text.data(), text.size());
+        stored[text.size()] = '\0';
+        cursor_ += required;
+        remaining_ -= required;
+        return std::string_view(stored, text.size());
+    }
+
+    mutable std::mutex mutex_;
+    std::unordered_set<std::string_view> strings_;
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    char *cursor_ = nullptr;
+    size_t remaining_ = 0;
+    size_t capacity_ = 0;
+};
+
+/**
+ * Intern the contents of a char mxArray. Short strings are converted
+ * through a stack buffer, so no temporary heap string is created; if their
+ * multibyte encoding does not fit, they take the mxArrayToString path.
+ */
+inline std::optional<InternedString> internMxArrayString(const mxArray *array)
+{
+    char buffer[256];
+    if (mxGetNumberOfElements(array) < sizeof(buffer) && mxGetString(array, buffer, sizeof(buffer)) == 0)
+        return StringPool::Instance().Intern(buffer);
+
+    char *converted = mxArrayToString(array);
+    if (converted == nullptr)
+        return std::nullopt;
+    InternedString result = StringPool::Instance().Intern(converted);
+    mxFree(converted);
+    return result;
+}
+
+// Specialization for InternedString
+template <>
+inline std::optional<InternedString> extractSFunctionParameter<InternedString>(SimStruct *S, int paramIndex)
+{
+    const mxArray *param = getSFunctionParameterChecked(S, paramIndex);
+    if (param == nullptr)
+        return std::nullopt;
+    if (!mxIsChar(param))
+    {
+        SetErrorStatusf(S, "Parameter at index %d is not a string but %s", paramIndex, mxGetClassName(param));
+        return std::nullopt;
+    }
+    std::optional<InternedString> result = internMxArrayString(param);
+    if (!result)
+    {
+        SetErrorStatusf(S, "Failed to convert parameter at index %d to string", paramIndex);
+    }
+    return result;
+}
+
+// Specialization for std::vector<InternedString>
+template <>
+inline std::optional<std::vector<InternedString>> extractSFunctionParameter<std::vector<InternedString>>(SimStruct *S, int paramIndex)
+{
+    const mxArray *param = getSFunctionParameterChecked(S, paramIndex);
+    if (param == nullptr)
+        return std::nullopt;
+    if (!mxIsCell(param))
+    {
+        SetErrorStatusf(S, "Parameter at index %d is not a cell array but %s", paramIndex, mxGetClassName(param));
+        return std::nullopt;
+    }
+    mwSize numElements = mxGetNumberOfElements(param);
+    std::vector<InternedString> result;
+    result.reserve(numElements);
+    for (mwSize i = 0; i < numElements; ++i)
+    {
+        const mxArray *cellElement = mxGetCell(param, i);
+        if (cellElement == nullptr || !mxIsChar(cellElement))
+        {
+            SetErrorStatusf(S, "Cell element %zu in parameter at index %d is not a string", (size_t)i, paramIndex);
+            return std::nullopt;
+        }
+        std::optional<InternedString> name = internMxArrayString(cellElement);
+        if (!name)
+        {
+            SetErrorStatusf(S, "Failed to convert cell element %zu to string in parameter at index %d", (size_t)i, paramIndex);
+            return std::nullopt;
+        }
+        result.push_back(*name);
+    }
+    return result;
+}
+
+/**
+ * Same as extractSFunctionMaskTable(), but returns interned strings instead
+ * of allocating a std::string per cell. Numeric cells are formatted with %f.
+ */
+inline std::optional<std::vector<std::vector<InternedString>>> extractSFunctionMaskTableInterned(SimStruct *S, int paramIndex)
+{
+    const mxArray *param = getSFunctionParameterChecked(S, paramIndex);
+    if (param == nullptr)
+        return std::nullopt;
+    if (!mxIsCell(param))
+    {
+        SetErrorStatusf(S, "Parameter at index %d is not a cell array but %s", paramIndex, mxGetClassName(param));
+        return std::nullopt;
+    }
+
+    const mwSize *dims = mxGetDimensions(param);
+    std::vector<std::vector<InternedString>> result(dims[0], std::vector<InternedString>(dims[1]));
+    for (mwSize i = 0; i < dims[0]; ++i)
+    {
+        for (mwSize j = 0; j < dims[1]; ++j)
+        {
+            const mxArray *cellElement = mxGetCell(param, i + dims[0] * j);
+            std::optional<InternedString> value;
+            if (cellElement != nullptr && mxIsChar(cellElement))
+            {
+                value = internMxArrayString(cellElement);
+            }
+            else if (cellElement != nullptr && mxIsDouble(cellElement))
+            {
+                char buffer[32];
+                std::snprintf(buffer, sizeof(buffer), "%f", mxGetScalar(cellElement));
+                value = StringPool::Instance().Intern(buffer);
+            }
+            if (!value)
+            {
+                SetErrorStatusf(S, "Cell element %zu in parameter at index %d is not a string", (size_t)i, paramIndex);
+                return std::nullopt;
+            }
+            result[i][j] = *value;
+        }
+    }
+    return result;
+}
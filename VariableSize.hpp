@@ -0,0 +1,167 @@
+#pragma once
+
+#include "IO.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+
+/**
+ * Define a variable-size input port of at most maxRows x maxCols elements
+ * (maxCols = 1 for a vector). Simulink allocates the port buffer for the
+ * maximum size once; each step only its current dimensions change.
+ */
+template <typename T>
+void DefineVariableSizeInputPort(SimStruct *S, int portIndex, int maxRows, int maxCols = 1, int isDirectFeedthrough = 0)
+{
+    DefineInputPort<T>(S, portIndex, maxRows, maxCols, isDirectFeedthrough);
+    if (ssGetNumInputPorts(S) <= portIndex)
+        return;
+
+    ssSetInputPortDimensionsMode(S, portIndex, VARIABLE_DIMS_MODE);
+}
+
+/** Define a variable-size output port of at most maxRows x maxCols elements, see DefineVariableSizeInputPort(). */
+template <typename T>
+void DefineVariableSizeOutputPort(SimStruct *S, int portIndex, int maxRows, int maxCols = 1)
+{
+    DefineOutputPort<T>(S, portIndex, maxRows, maxCols);
+    if (ssGetNumOutputPorts(S) <= portIndex)
+        return;
+
+    ssSetOutputPortDimensionsMode(S, portIndex, VARIABLE_DIMS_MODE);
+}
+
+namespace variable_size_detail
+{
+    template <typename T>
+    T *InputSignal(SimStruct *S, int portIndex, size_t maxSize)
+    {
+        if (ssGetNumInputPorts(S) > portIndex && ssGetInputPortDimensionsMode(S, portIndex) != VARIABLE_DIMS_MODE)
+        {
+            SetErrorStatusf(S, "Input port %d is not variable-size, check DefineVariableSizeInputPort()", portIndex);
+            return nullptr;
+        }
+        return GetInputPortSignal<T>(S, portIndex, maxSize);
+    }
+
+    template <typename T>
+    T *OutputSignal(SimStruct *S, int portIndex, size_t maxSize)
+    {
+        if (ssGetNumOutputPorts(S) > portIndex && ssGetOutputPortDimensionsMode(S, portIndex) != VARIABLE_DIMS_MODE)
+        {
+            SetErrorStatusf(S, "Output port %d is not variable-size, check DefineVariableSizeOutputPort()", portIndex);
+            return nullptr;
+        }
+        return GetOutputPortSignal<T>(S, portIndex, maxSize);
+    }
+}
+
+/**
+ * View over the elements of a variable-size vector input port in the
+ * current step; size() is the current width, at most maxWidth.
+ */
+template <typename T>
+std::optional<InputPortView<T>> GetVariableSizeInputPortView(SimStruct *S, int portIndex, size_t maxWidth)
+{
+    SFU_INSTRUMENT(S, InputPorts);
+    const T *inputSignal = variable_size_detail::InputSignal<T>(S, portIndex, maxWidth);
+    if (!inputSignal)
+        return std::nullopt;
+
+    const int_T width = ssGetCurrentInputPortWidth(S, portIndex);
+    if (width < 0 || (size_t)width > maxWidth)
+    {
+        SetErrorStatusf(S, "Current width %d of input port %d exceeds its maximum width %zu", width, portIndex, maxWidth);
+        return std::nullopt;
+    }
+    return InputPortView<T>(inputSignal, (size_t)width);
+}
+
+/**
+ * View over a variable-size matrix input port in the current step. The
+ * elements are packed column-major with the current number of rows, so
+ * element (row, col) is at data[row + col * rows()].
+ */
+template <typename T>
+std::optional<InputMatrixView<T>> GetVariableSizeInputMatrixView(SimStruct *S, int portIndex, size_t maxRows, size_t maxCols)
+{
+    SFU_INSTRUMENT(S, InputPorts);
+    const T *inputSignal = variable_size_detail::InputSignal<T>(S, portIndex, maxRows * maxCols);
+    if (!inputSignal)
+        return std::nullopt;
+
+    const int_T rows = ssGetCurrentInputPortDimensions(S, portIndex, 0);
+    const int_T cols = ssGetInputPortNumDimensions(S, portIndex) > 1 ? ssGetCurrentInputPortDimensions(S, portIndex, 1) : 1;
+    if (rows < 0 || cols < 0 || (size_t)rows > maxRows || (size_t)cols > maxCols)
+    {
+        SetErrorStatusf(S, "Current dimensions %dx%d of input port %d exceed its maximum %zux%zu", rows, cols, portIndex, maxRows, maxCols);
+        return std::nullopt;
+    }
+    return InputMatrixView<T>(inputSignal, (size_t)rows, (size_t)cols);
+}
+
+/**
+ * Set the current width of a variable-size vector output port to width and
+ * return a view over those elements, to be written in place. On a 2-D port
+ * the current dimensions become width x 1.
+ */
+template <typename T>
+std::optional<OutputPortView<T>> GetVariableSizeOutputPortView(SimStruct *S, int portIndex, size_t maxWidth, size_t width)
+{
+    SFU_INSTRUMENT(S, OutputPorts);
+    T *outputSignal = variable_size_detail::OutputSignal<T>(S, portIndex, maxWidth);
+    if (!outputSignal)
+        return std::nullopt;
+
+    if (width > maxWidth)
+    {
+        SetErrorStatusf(S, "Width %zu exceeds the maximum width %zu of output port %d", width, maxWidth, portIndex);
+        return std::nullopt;
+    }
+    // A 2-D port becomes width x 1, so width is limited by its maximum number of rows
+    const bool isMatrix = ssGetOutputPortNumDimensions(S, portIndex) > 1;
+    if (isMatrix && width > (size_t)ssGetOutputPortDimensions(S, portIndex)[0])
+    {
+        SetErrorStatusf(S, "Width %zu exceeds the maximum of %d rows of output port %d, use GetVariableSizeOutputMatrixView()", width, ssGetOutputPortDimensions(S, portIndex)[0], portIndex);
+        return std::nullopt;
+    }
+    ssSetCurrentOutputPortDimensions(S, portIndex, 0, (int_T)width);
+    if (isMatrix)
+        ssSetCurrentOutputPortDimensions(S, portIndex, 1, 1);
+    return OutputPortView<T>(outputSignal, width);
+}
+
+/**
+ * Set the current dimensions of a variable-size matrix output port to
+ * rows x cols and return a view over them (packed column-major).
+ */
+template <typename T>
+std::optional<OutputMatrixView<T>> GetVariableSizeOutputMatrixView(SimStruct *S, int portIndex, size_t maxRows, size_t maxCols, size_t rows, size_t cols)
+{
+    SFU_INSTRUMENT(S, OutputPorts);
+    T *outputSignal = variable_size_detail::OutputSignal<T>(S, portIndex, maxRows * maxCols);
+    if (!outputSignal)
+        return std::nullopt;
+
+    if (rows > maxRows || cols > maxCols)
+    {
+        SetErrorStatusf(S, "Dimensions %zux%zu exceed the maximum %zux%zu of output port %d", rows, cols, maxRows, maxCols, portIndex);
+        return std::nullopt;
+    }
+    ssSetCurrentOutputPortDimensions(S, portIndex, 0, (int_T)rows);
+    if (ssGetOutputPortNumDimensions(S, portIndex) > 1)
+        ssSetCurrentOutputPortDimensions(S, portIndex, 1, (int_T)cols);
+    return OutputMatrixView<T>(outputSignal, rows, cols);
+}
+
+/** Copy count values to a variable-size vector output port and make count its current width. */
+template <typename T>
+bool SetVariableSizeOutputPort(SimStruct *S, int portIndex, size_t maxWidth, const T *values, size_t count)
+{
+    std::optional<OutputPortView<T>> output = GetVariableSizeOutputPortView<T>(S, portIndex, maxWidth, count);
+    if (!output)
+        return false;
+
+    std::copy(values, values + count, output->data());
+    return true;
+}
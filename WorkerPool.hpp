@@ -0,0 +1,330 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+// Busy-wait iterations of an idle worker before it parks on a condition variable
+#ifndef SFU_WORKER_SPIN_ITERATIONS
+#define SFU_WORKER_SPIN_ITERATIONS 20000
+#endif
+
+namespace worker_pool_detail
+{
+    inline void CpuRelax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+#endif
+    }
+
+    // CPUs the process may run on (cpusets, taskset, container limits), in ascending order
+    inline std::vector<size_t> AllowedCpus()
+    {
+        std::vector<size_t> cpus;
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0)
+        {
+            for (size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            {
+                if (CPU_ISSET(cpu, &set))
+                    cpus.push_back(cpu);
+            }
+        }
+#elif defined(_WIN32)
+        DWORD_PTR processMask = 0;
+        DWORD_PTR systemMask = 0;
+        if (GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask))
+        {
+            for (size_t cpu = 0; cpu < 8 * sizeof(DWORD_PTR); ++cpu)
+            {
+                if (processMask & (DWORD_PTR(1) << cpu))
+                    cpus.push_back(cpu);
+            }
+        }
+#endif
+        if (cpus.empty())
+        {
+            for (size_t cpu = 0; cpu < std::max<size_t>(std::thread::hardware_concurrency(), 1); ++cpu)
+                cpus.push_back(cpu);
+        }
+        return cpus;
+    }
+
+    // Shared by all pools of the process, so pinned workers of different blocks use different CPUs
+    inline std::atomic<size_t> nextPinnedCpu{0};
+
+    // Next allowed CPU for a pinned worker; the first allowed CPU is left to the simulation thread
+    inline size_t ClaimCpu(const std::vector<size_t> &cpus)
+    {
+        if (cpus.size() == 1)
+            return cpus[0];
+        return cpus[1 + nextPinnedCpu.fetch_add(1, std::memory_order_relaxed) % (cpus.size() - 1)];
+    }
+
+    inline bool PinThread(std::thread &thread, size_t cpu)
+    {
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+        return cpu < 8 * sizeof(DWORD_PTR) && SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << cpu) != 0;
+#else
+        (void)thread;
+        (void)cpu;
+        return false;
+#endif
+    }
+
+    // Work word: generation (32 bits) | next chunk (16 bits) | chunk count (16 bits)
+    constexpr uint64_t Pack(uint32_t generation, uint32_t next, uint32_t count)
+    {
+        return (uint64_t(generation) << 32) | (uint64_t(next) << 16) | count;
+    }
+    constexpr uint32_t Generation(uint64_t work) { return uint32_t(work >> 32); }
+    constexpr uint32_t Next(uint64_t work) { return uint32_t(work >> 16) & 0xFFFF; }
+    constexpr uint32_t Count(uint64_t work) { return uint32_t(work) & 0xFFFF; }
+    constexpr uint32_t MaxChunks = 0xFFFF;
+}
+
+/**
+ * Persistent worker threads for splitting the work of one mdlOutputs call
+ * over all cores:
+ *
+ *   mdlStart:     pool.Start();   // one worker per allowed CPU but one
+ *   mdlOutputs:   pool.ParallelFor(points.size(), [&](size_t begin, size_t end) {
+ *                     for (size_t i = begin; i < end; ++i)
+ *                         filtered[i] = Filter(points[i]);
+ *                 });
+ *   mdlTerminate: pool.Stop();    // joins the workers
+ *
+ * Keep the pool in the block's state (e.g. a StateArena), one per instance.
+ * The range is cut into chunks that the calling thread and the workers
+ * claim dynamically; ParallelFor() returns once every chunk is done.
+ * Dispatch does not allocate or take a lock while the workers are spinning.
+ * Idle workers spin for SFU_WORKER_SPIN_ITERATIONS pause instructions, so a
+ * ParallelFor() in the next time step reaches them in microseconds, and
+ * then park so an idle model does not burn cores. Bodies must not throw.
+ *
+ * ParallelFor() must only be called from one thread at a time.
+ */
+class WorkerPool
+{
+public:
+    WorkerPool() = default;
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+    ~WorkerPool() { Stop(); }
+
+    /**
+     * Start workerCount threads (one less than the CPUs the process may use
+     * if 0). With pinThreads, each worker is bound to one of those CPUs,
+     * skipping the first one, which is left to the simulation thread. CPUs
+     * are handed out round-robin across all pools of the process, so two
+     * pinned pools only share CPUs once every CPU has a worker. Returns
+     * false if the pool is running, a thread could not be created or a
+     * worker could not be pinned (the pool is stopped then).
+     */
+    bool Start(size_t workerCount = 0, bool pinThreads = false, unsigned spinIterations = SFU_WORKER_SPIN_ITERATIONS)
+    {
+        if (!workers_.empty())
+            return false;
+
+        const std::vector<size_t> allowedCpus = worker_pool_detail::AllowedCpus();
+        const size_t cpus = allowedCpus.size();
+        if (workerCount == 0)
+            workerCount = cpus - 1;
+        // Spinning on an oversubscribed machine only delays the thread doing the work
+        spinIterations_ = workerCount < cpus ? spinIterations : 0;
+        stop_.store(false, std::memory_order_relaxed);
+        const uint32_t generation = worker_pool_detail::Generation(work_.load(std::memory_order_relaxed));
+
+        try
+        {
+            workers_.reserve(workerCount);
+            for (size_t i = 0; i < workerCount; ++i)
+            {
+                workers_.emplace_back([this, generation] { WorkerLoop(generation); });
+                if (pinThreads && !worker_pool_detail::PinThread(workers_.back(), worker_pool_detail::ClaimCpu(allowedCpus)))
+                {
+                    Stop();
+                    return false;
+                }
+            }
+        }
+        catch (const std::system_error &)
+        {
+            Stop();
+            return false;
+        }
+        return true;
+    }
+
+    /** Wake and join all workers. Safe to call if the pool was never started. */
+    void Stop()
+    {
+        if (workers_.empty())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(parkMutex_);
+            stop_.store(true, std::memory_order_seq_cst);
+        }
+        parkCondition_.notify_all();
+        for (std::thread &worker : workers_)
+            worker.join();
+        workers_.clear();
+    }
+
+    bool Running() const noexcept { return !workers_.empty(); }
+
+    /** Worker threads plus the calling thread. */
+    size_t Concurrency() const noexcept { return workers_.size() + 1; }
+
+    /**
+     * Call body(begin, end) on disjoint subranges covering [0, count),
+     * concurrently on the calling thread and the workers. Subranges hold at
+     * least minChunk elements (except the last one), so keep minChunk large
+     * enough to amortise the per-chunk cost.
+     */
+    template <typename Body>
+    void ParallelFor(size_t count, Body &&body, size_t minChunk = 1)
+    {
+        using namespace worker_pool_detail;
+        if (count == 0)
+            return;
+        minChunk = std::max<size_t>(minChunk, 1);
+        if (workers_.empty() || count <= minChunk)
+        {
+            body(size_t(0), count);
+            return;
+        }
+
+        // A few chunks per thread balance uneven element costs
+        const size_t target = (count + 4 * Concurrency() - 1) / (4 * Concurrency());
+        size_t chunkSize = std::max(minChunk, target);
+        chunkSize = std::max(chunkSize, (count + MaxChunks - 1) / MaxChunks);
+        const uint32_t chunks = uint32_t((count + chunkSize - 1) / chunkSize);
+
+        using BodyType = std::remove_reference_t<Body>;
+        job_.invoke = [](void *context, size_t begin, size_t end)
+        { (*static_cast<BodyType *>(context))(begin, end); };
+        job_.context = const_cast<void *>(static_cast<const void *>(&body));
+        job_.count = count;
+        job_.chunkSize = chunkSize;
+        completed_.store(0, std::memory_order_relaxed);
+
+        const uint32_t generation = Generation(work_.load(std::memory_order_relaxed)) + 1;
+        work_.store(Pack(generation, 0, chunks), std::memory_order_seq_cst);
+        if (parked_.load(std::memory_order_seq_cst) > 0)
+        {
+            std::lock_guard<std::mutex> lock(parkMutex_);
+            parkCondition_.notify_all();
+        }
+
+        RunChunks(generation);
+        for (unsigned spins = 0; completed_.load(std::memory_order_acquire) < chunks; ++spins)
+        {
+            if (spins < spinIterations_)
+                CpuRelax();
+            else
+                std::this_thread::yield();
+        }
+    }
+
+private:
+    struct Job
+    {
+        void (*invoke)(void *context, size_t begin, size_t end) = nullptr;
+        void *context = nullptr;
+        size_t count = 0;
+        size_t chunkSize = 0;
+    };
+
+    // Claim and run chunks of the given generation until none are left
+    void RunChunks(uint32_t generation)
+    {
+        using namespace worker_pool_detail;
+        uint64_t work = work_.load(std::memory_order_acquire);
+        while (Generation(work) == generation && Next(work) < Count(work))
+        {
+            if (!work_.compare_exchange_weak(work, work + (uint64_t(1) << 16), std::memory_order_acquire))
+                continue;
+            // The job cannot be replaced before this chunk is completed
+            const size_t begin = Next(work) * job_.chunkSize;
+            const size_t end = std::min(begin + job_.chunkSize, job_.count);
+            job_.invoke(job_.context, begin, end);
+            completed_.fetch_add(1, std::memory_order_release);
+            work = work_.load(std::memory_order_acquire);
+        }
+    }
+
+    void WorkerLoop(uint32_t seen)
+    {
+        using namespace worker_pool_detail;
+        while (true)
+        {
+            unsigned spins = 0;
+            uint32_t generation;
+            while ((generation = Generation(work_.load(std::memory_order_acquire))) == seen)
+            {
+                if (stop_.load(std::memory_order_relaxed))
+                    return;
+                if (spins++ < spinIterations_)
+                {
+                    CpuRelax();
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(parkMutex_);
+                parked_.fetch_add(1, std::memory_order_seq_cst);
+                parkCondition_.wait(lock, [&]
+                                    { return stop_.load(std::memory_order_seq_cst) ||
+                                             Generation(work_.load(std::memory_order_seq_cst)) != seen; });
+                parked_.fetch_sub(1, std::memory_order_relaxed);
+                spins = 0;
+            }
+            seen = generation;
+            RunChunks(generation);
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    unsigned spinIterations_ = 0;
+    Job job_;
+
+    // Written by the dispatching thread, polled by the workers
+    alignas(64) std::atomic<uint64_t> work_{0};
+    alignas(64) std::atomic<uint32_t> completed_{0};
+    alignas(64) std::atomic<int> parked_{0};
+    std::atomic<bool> stop_{false};
+    std::mutex parkMutex_;
+    std::condition_variable parkCondition_;
+};